@@ -0,0 +1,173 @@
+/*
+ * bench_load.c
+ * Text loading throughput: fgets + sscanf + push_back against zlist_load().
+ * Prints one JSON object to stdout.
+ *
+ * Build: gcc -std=c11 -O2 -I. bench/bench_load.c -o bench_load
+ * Usage: ./bench_load [records]
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+typedef struct
+{
+    int id;
+    double x, y;
+} Record;
+
+#define REGISTER_ZLIST_TYPES(X) \
+    X(Record, Record)
+
+#define ZLIST_ENABLE_IO
+#include "zlist.h"
+
+#define RUNS 3
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Fixed-point decimal ("-12.345"), bounded by 'end'.
+static const char *parse_decimal(const char *p, const char *end, double *out)
+{
+    double sign = 1.0, v = 0.0, scale = 1.0;
+    if (p < end && *p == '-')
+    {
+        sign = -1.0;
+        p++;
+    }
+    for (; p < end && *p >= '0' && *p <= '9'; p++) v = v * 10.0 + (*p - '0');
+    if (p < end && *p == '.')
+    {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++)
+        {
+            scale *= 0.1;
+            v += (*p - '0') * scale;
+        }
+    }
+    *out = sign * v;
+    return p;
+}
+
+// "id,x,y"
+static int parse_record(const char *line, size_t len, Record *out, void *ctx)
+{
+    const char *p = line, *end = line + len;
+    double id;
+    (void)ctx;
+    p = parse_decimal(p, end, &id);
+    if (p == end || *p++ != ',') return -1;
+    p = parse_decimal(p, end, &out->x);
+    if (p == end || *p++ != ',') return -1;
+    p = parse_decimal(p, end, &out->y);
+    out->id = (int)id;
+    return p == end ? 1 : -1;
+}
+
+static double run_fgets_sscanf(const char *path, size_t *count)
+{
+    char line[256];
+    Record r;
+    double t0 = now_sec();
+    FILE *f = fopen(path, "r");
+    zlist_Record l = zlist_init(Record);
+    while (fgets(line, sizeof(line), f))
+    {
+        if (3 == sscanf(line, "%d,%lf,%lf", &r.id, &r.x, &r.y)) zlist_push_back(&l, r);
+    }
+    fclose(f);
+    double t = now_sec() - t0;
+    *count = l.length;
+    zlist_clear(&l);
+    return t;
+}
+
+static double run_fgets_parse(const char *path, size_t *count)
+{
+    char line[256];
+    Record r;
+    double t0 = now_sec();
+    FILE *f = fopen(path, "r");
+    zlist_Record l = zlist_init(Record);
+    while (fgets(line, sizeof(line), f))
+    {
+        size_t len = strcspn(line, "\r\n");
+        if (1 == parse_record(line, len, &r, NULL)) zlist_push_back(&l, r);
+    }
+    fclose(f);
+    double t = now_sec() - t0;
+    *count = l.length;
+    zlist_clear(&l);
+    return t;
+}
+
+static double run_zlist_load(const char *path, size_t *count)
+{
+    double t0 = now_sec();
+    int fd = open(path, O_RDONLY);
+    zlist_Record l = zlist_init(Record);
+    if (Z_OK != zlist_load(&l, fd, parse_record, NULL)) l.length = 0;
+    close(fd);
+    double t = now_sec() - t0;
+    *count = l.length;
+    zlist_clear(&l);
+    return t;
+}
+
+int main(int argc, char **argv)
+{
+    size_t records = argc > 1 ? strtoul(argv[1], NULL, 10) : 2000000;
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/zlist_bench_load_%ld.csv", (long)getpid());
+
+    FILE *f = fopen(path, "w");
+    if (!f) return 1;
+    srand(42);
+    for (size_t i = 0; i < records; i++)
+    {
+        fprintf(f, "%zu,%.3f,%.3f\n", i, rand() / 1000.0, -rand() / 1000.0);
+    }
+    long bytes = ftell(f);
+    fclose(f);
+
+    static const struct
+    {
+        const char *name;
+        double (*run)(const char *, size_t *);
+    } cases[] =
+    {
+        { "fgets_sscanf_push_back", run_fgets_sscanf },
+        { "fgets_parse_push_back",  run_fgets_parse },
+        { "zlist_load",             run_zlist_load },
+    };
+
+    printf("{\n  \"benchmark\": \"load\",\n  \"records\": %zu,\n  \"bytes\": %ld,\n  \"results\": [\n",
+           records, bytes);
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+    {
+        double best = 1e30;
+        size_t count = 0;
+        for (int r = 0; r < RUNS; r++)
+        {
+            double t = cases[c].run(path, &count);
+            if (t < best) best = t;
+        }
+        printf("    { \"name\": \"%s\", \"seconds\": %.6f, \"mb_per_s\": %.1f, \"records\": %zu }%s\n",
+               cases[c].name, best, bytes / best / 1e6, count,
+               c + 1 < sizeof(cases) / sizeof(cases[0]) ? "," : "");
+    }
+    printf("  ]\n}\n");
+
+    remove(path);
+    return 0;
+}
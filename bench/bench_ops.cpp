@@ -0,0 +1,493 @@
+
+/*
+ * bench_ops.cpp
+ * Core list operations on zlist against std::list, std::deque, std::vector and
+ * a sys/queue.h TAILQ, over several payload sizes and lengths, with warm and
+ * cold caches. Prints one JSON object to stdout.
+ *
+ * Build: g++ -std=c++11 -O2 -I. bench/bench_ops.cpp -o bench_ops
+ * Usage: ./bench_ops [max_length] [flush_mib]
+ *
+ * Every sample builds its input, optionally evicts the caches by streaming over a
+ * 'flush_mib' buffer (cold), then times the operation alone. The best of REPS
+ * samples is reported. Middle-of-list operations (insert_after, remove_node, at)
+ * touch up to MID_OPS evenly spaced positions; their positions are looked up
+ * before the clock starts.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/queue.h>
+
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <vector>
+
+template<size_t N>
+struct Payload
+{
+    unsigned char bytes[N];
+};
+
+typedef Payload<8>   P8;
+typedef Payload<64>  P64;
+typedef Payload<256> P256;
+
+#define REGISTER_ZLIST_TYPES(X) \
+    X(P8, P8)                   \
+    X(P64, P64)                 \
+    X(P256, P256)
+
+#include "zlist.h"
+
+#define REPS        5
+#define MID_OPS     64
+#define FRONT_LIMIT 4096 // std::vector front operations are O(n); skip them past this.
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static unsigned char *flush_buf;
+static size_t flush_size;
+static volatile unsigned long sink;
+
+// Streams over a buffer larger than the caches we care about.
+static void flush_caches(void)
+{
+    unsigned long acc = 0;
+    for (size_t i = 0; i < flush_size; i += 64)
+    {
+        flush_buf[i]++;
+        acc += flush_buf[i];
+    }
+    sink += acc;
+}
+
+template<class P>
+static P make(size_t i)
+{
+    P p;
+    memset(p.bytes, (int)(i & 0xff), sizeof(p.bytes));
+    return p;
+}
+
+// Evenly spaced positions in [0, n), ascending.
+static std::vector<size_t> mid_positions(size_t n)
+{
+    std::vector<size_t> pos;
+    size_t k = n < MID_OPS ? n : MID_OPS;
+    for (size_t i = 0; i < k; i++) pos.push_back(i * n / k);
+    return pos;
+}
+
+/* Adapters. Each exposes the same operations over one container. */
+
+template<class P>
+struct ZListAdapter
+{
+    typedef z_list::traits<P> tr;
+    typedef typename tr::list_type list_type;
+    typedef typename tr::node_type node_type;
+
+    static const char *name() { return "zlist"; }
+    static bool slow_front() { return false; }
+
+    list_type l;
+    std::vector<node_type *> marks;
+
+    ZListAdapter() : l(tr::init()) {}
+    ~ZListAdapter() { tr::clear(&l); }
+
+    void push_back(const P &v) { tr::push_back(&l, v); }
+    void push_front(const P &v) { tr::push_front(&l, v); }
+    void pop_back() { tr::pop_back(&l); }
+    void pop_front() { tr::pop_front(&l); }
+    bool empty() const { return 0 == l.length; }
+    void clear() { tr::clear(&l); }
+    void reverse() { tr::reverse(&l); }
+    void splice(ZListAdapter &src) { tr::splice(&l, &src.l); }
+
+    void mark(const std::vector<size_t> &pos)
+    {
+        marks.clear();
+        for (size_t i = 0; i < pos.size(); i++) marks.push_back(tr::at(&l, pos[i]));
+    }
+    void insert_marked(const P &v)
+    {
+        for (size_t i = 0; i < marks.size(); i++) tr::insert_after(&l, marks[i], v);
+    }
+    void remove_marked()
+    {
+        for (size_t i = 0; i < marks.size(); i++) tr::remove_node(&l, marks[i]);
+    }
+    unsigned long at(const std::vector<size_t> &pos)
+    {
+        unsigned long acc = 0;
+        for (size_t i = 0; i < pos.size(); i++) acc += tr::at(&l, pos[i])->value.bytes[0];
+        return acc;
+    }
+    unsigned long foreach()
+    {
+        unsigned long acc = 0;
+        for (node_type *n = l.head; n; n = n->next) acc += n->value.bytes[0];
+        return acc;
+    }
+};
+
+template<class P>
+struct StdListAdapter
+{
+    static const char *name() { return "std::list"; }
+    static bool slow_front() { return false; }
+
+    std::list<P> c;
+    std::vector<typename std::list<P>::iterator> marks;
+
+    void push_back(const P &v) { c.push_back(v); }
+    void push_front(const P &v) { c.push_front(v); }
+    void pop_back() { c.pop_back(); }
+    void pop_front() { c.pop_front(); }
+    bool empty() const { return c.empty(); }
+    void clear() { c.clear(); }
+    void reverse() { c.reverse(); }
+    void splice(StdListAdapter &src) { c.splice(c.end(), src.c); }
+
+    void mark(const std::vector<size_t> &pos)
+    {
+        marks.clear();
+        typename std::list<P>::iterator it = c.begin();
+        size_t at = 0;
+        for (size_t i = 0; i < pos.size(); i++)
+        {
+            std::advance(it, pos[i] - at);
+            at = pos[i];
+            marks.push_back(it);
+        }
+    }
+    void insert_marked(const P &v)
+    {
+        for (size_t i = 0; i < marks.size(); i++) c.insert(std::next(marks[i]), v);
+    }
+    void remove_marked()
+    {
+        for (size_t i = 0; i < marks.size(); i++) c.erase(marks[i]);
+    }
+    unsigned long at(const std::vector<size_t> &pos)
+    {
+        unsigned long acc = 0;
+        for (size_t i = 0; i < pos.size(); i++)
+        {
+            acc += std::next(c.begin(), (long)pos[i])->bytes[0];
+        }
+        return acc;
+    }
+    unsigned long foreach()
+    {
+        unsigned long acc = 0;
+        for (typename std::list<P>::iterator it = c.begin(); it != c.end(); ++it)
+        {
+            acc += it->bytes[0];
+        }
+        return acc;
+    }
+};
+
+// std::vector and std::deque share everything but the container and push_front.
+template<class C, class P>
+struct SeqAdapter
+{
+    C c;
+    std::vector<size_t> marks;
+
+    void push_back(const P &v) { c.push_back(v); }
+    void pop_back() { c.pop_back(); }
+    void pop_front() { c.erase(c.begin()); }
+    bool empty() const { return c.empty(); }
+    void clear() { c.clear(); }
+    void reverse() { std::reverse(c.begin(), c.end()); }
+
+    void mark(const std::vector<size_t> &pos) { marks = pos; }
+    void insert_marked(const P &v)
+    {
+        // Back to front so earlier indices stay valid.
+        for (size_t i = marks.size(); i-- > 0;) c.insert(c.begin() + (long)marks[i] + 1, v);
+    }
+    void remove_marked()
+    {
+        for (size_t i = marks.size(); i-- > 0;) c.erase(c.begin() + (long)marks[i]);
+    }
+    unsigned long at(const std::vector<size_t> &pos)
+    {
+        unsigned long acc = 0;
+        for (size_t i = 0; i < pos.size(); i++) acc += c[pos[i]].bytes[0];
+        return acc;
+    }
+    unsigned long foreach()
+    {
+        unsigned long acc = 0;
+        for (typename C::iterator it = c.begin(); it != c.end(); ++it) acc += it->bytes[0];
+        return acc;
+    }
+};
+
+template<class P>
+struct VectorAdapter : SeqAdapter<std::vector<P>, P>
+{
+    static const char *name() { return "std::vector"; }
+    static bool slow_front() { return true; }
+    void push_front(const P &v) { this->c.insert(this->c.begin(), v); }
+    void splice(VectorAdapter &src)
+    {
+        this->c.insert(this->c.end(), src.c.begin(), src.c.end());
+        src.c.clear();
+    }
+};
+
+template<class P>
+struct DequeAdapter : SeqAdapter<std::deque<P>, P>
+{
+    static const char *name() { return "std::deque"; }
+    static bool slow_front() { return false; }
+    void push_front(const P &v) { this->c.push_front(v); }
+    void pop_front() { this->c.pop_front(); }
+    void splice(DequeAdapter &src)
+    {
+        this->c.insert(this->c.end(), src.c.begin(), src.c.end());
+        src.c.clear();
+    }
+};
+
+template<class P>
+struct TailqNode
+{
+    TAILQ_ENTRY(TailqNode) link;
+    P value;
+};
+
+template<class P>
+struct TailqAdapter
+{
+    typedef TailqNode<P> node_type;
+    TAILQ_HEAD(head_type, TailqNode<P>) h;
+    std::vector<node_type *> marks;
+
+    static const char *name() { return "TAILQ"; }
+    static bool slow_front() { return false; }
+
+    TailqAdapter() { TAILQ_INIT(&h); }
+    ~TailqAdapter() { clear(); }
+
+    static node_type *make_node(const P &v)
+    {
+        node_type *n = (node_type *)malloc(sizeof(node_type));
+        n->value = v;
+        return n;
+    }
+
+    void push_back(const P &v) { node_type *n = make_node(v); TAILQ_INSERT_TAIL(&h, n, link); }
+    void push_front(const P &v) { node_type *n = make_node(v); TAILQ_INSERT_HEAD(&h, n, link); }
+    void pop_back()
+    {
+        node_type *n = TAILQ_LAST(&h, head_type);
+        TAILQ_REMOVE(&h, n, link);
+        free(n);
+    }
+    void pop_front()
+    {
+        node_type *n = TAILQ_FIRST(&h);
+        TAILQ_REMOVE(&h, n, link);
+        free(n);
+    }
+    bool empty() const { return TAILQ_EMPTY(&h); }
+    void clear()
+    {
+        node_type *n;
+        while ((n = TAILQ_FIRST(&h)))
+        {
+            TAILQ_REMOVE(&h, n, link);
+            free(n);
+        }
+    }
+    // TAILQ has no reverse; move each node to the head in turn.
+    void reverse()
+    {
+        node_type *n = TAILQ_FIRST(&h), *next;
+        for (; n; n = next)
+        {
+            next = TAILQ_NEXT(n, link);
+            TAILQ_REMOVE(&h, n, link);
+            TAILQ_INSERT_HEAD(&h, n, link);
+        }
+    }
+    void splice(TailqAdapter &src) { TAILQ_CONCAT(&h, &src.h, link); }
+
+    node_type *nth(size_t i)
+    {
+        node_type *n = TAILQ_FIRST(&h);
+        while (i--) n = TAILQ_NEXT(n, link);
+        return n;
+    }
+    void mark(const std::vector<size_t> &pos)
+    {
+        marks.clear();
+        for (size_t i = 0; i < pos.size(); i++) marks.push_back(nth(pos[i]));
+    }
+    void insert_marked(const P &v)
+    {
+        for (size_t i = 0; i < marks.size(); i++)
+        {
+            node_type *n = make_node(v);
+            TAILQ_INSERT_AFTER(&h, marks[i], n, link);
+        }
+    }
+    void remove_marked()
+    {
+        for (size_t i = 0; i < marks.size(); i++)
+        {
+            TAILQ_REMOVE(&h, marks[i], link);
+            free(marks[i]);
+        }
+    }
+    unsigned long at(const std::vector<size_t> &pos)
+    {
+        unsigned long acc = 0;
+        for (size_t i = 0; i < pos.size(); i++) acc += nth(pos[i])->value.bytes[0];
+        return acc;
+    }
+    unsigned long foreach()
+    {
+        unsigned long acc = 0;
+        node_type *n;
+        TAILQ_FOREACH(n, &h, link) acc += n->value.bytes[0];
+        return acc;
+    }
+};
+
+/* Operations. setup() runs untimed; run() returns the number of elements it touched. */
+
+enum Op
+{
+    OP_PUSH_BACK, OP_PUSH_FRONT, OP_POP_BACK, OP_POP_FRONT, OP_INSERT_AFTER,
+    OP_REMOVE_NODE, OP_SPLICE, OP_REVERSE, OP_CLEAR, OP_AT, OP_FOREACH, OP_COUNT
+};
+
+static const char *op_names[OP_COUNT] =
+{
+    "push_back", "push_front", "pop_back", "pop_front", "insert_after",
+    "remove_node", "splice", "reverse", "clear", "at", "foreach"
+};
+
+template<class A, class P>
+static void fill(A &a, size_t n)
+{
+    for (size_t i = 0; i < n; i++) a.push_back(make<P>(i));
+}
+
+template<class A, class P>
+static double sample(Op op, size_t n, bool cold, size_t *touched)
+{
+    A a, other;
+    std::vector<size_t> pos = mid_positions(n);
+    const P v = make<P>(7);
+
+    if (op != OP_PUSH_BACK && op != OP_PUSH_FRONT) fill<A, P>(a, n);
+    if (op == OP_SPLICE) fill<A, P>(other, n);
+    if (op == OP_INSERT_AFTER || op == OP_REMOVE_NODE) a.mark(pos);
+    if (cold) flush_caches();
+    else if (op == OP_AT) sink += a.at(pos);
+    else if (op == OP_FOREACH) sink += a.foreach();
+
+    double t0 = now_ns();
+    switch (op)
+    {
+        case OP_PUSH_BACK:    for (size_t i = 0; i < n; i++) a.push_back(v); *touched = n; break;
+        case OP_PUSH_FRONT:   for (size_t i = 0; i < n; i++) a.push_front(v); *touched = n; break;
+        case OP_POP_BACK:     while (!a.empty()) a.pop_back(); *touched = n; break;
+        case OP_POP_FRONT:    while (!a.empty()) a.pop_front(); *touched = n; break;
+        case OP_INSERT_AFTER: a.insert_marked(v); *touched = pos.size(); break;
+        case OP_REMOVE_NODE:  a.remove_marked(); *touched = pos.size(); break;
+        case OP_SPLICE:       a.splice(other); *touched = 1; break;
+        case OP_REVERSE:      a.reverse(); *touched = n; break;
+        case OP_CLEAR:        a.clear(); *touched = n; break;
+        case OP_AT:           sink += a.at(pos); *touched = pos.size(); break;
+        case OP_FOREACH:      sink += a.foreach(); *touched = n; break;
+        default: break;
+    }
+    return now_ns() - t0;
+}
+
+static bool first_result = true;
+
+template<class A, class P>
+static void run_container(size_t n, bool cold)
+{
+    for (int op = 0; op < OP_COUNT; op++)
+    {
+        if (A::slow_front() && n > FRONT_LIMIT && (op == OP_PUSH_FRONT || op == OP_POP_FRONT))
+        {
+            printf("%s    { \"op\": \"%s\", \"container\": \"%s\", \"payload\": %zu, \"length\": %zu, "
+                   "\"cache\": \"%s\", \"ns\": null, \"ns_per_elem\": null }",
+                   first_result ? "" : ",\n", op_names[op], A::name(), sizeof(P), n,
+                   cold ? "cold" : "warm");
+            first_result = false;
+            continue;
+        }
+        double best = 1e30;
+        size_t touched = 1;
+        for (int r = 0; r < REPS; r++)
+        {
+            double t = sample<A, P>((Op)op, n, cold, &touched);
+            if (t < best) best = t;
+        }
+        printf("%s    { \"op\": \"%s\", \"container\": \"%s\", \"payload\": %zu, \"length\": %zu, "
+               "\"cache\": \"%s\", \"ns\": %.0f, \"ns_per_elem\": %.2f }",
+               first_result ? "" : ",\n", op_names[op], A::name(), sizeof(P), n,
+               cold ? "cold" : "warm", best, touched ? best / (double)touched : 0.0);
+        first_result = false;
+    }
+}
+
+template<class P>
+static void run_payload(size_t n, bool cold)
+{
+    run_container<ZListAdapter<P>, P>(n, cold);
+    run_container<StdListAdapter<P>, P>(n, cold);
+    run_container<DequeAdapter<P>, P>(n, cold);
+    run_container<VectorAdapter<P>, P>(n, cold);
+    run_container<TailqAdapter<P>, P>(n, cold);
+}
+
+int main(int argc, char **argv)
+{
+    size_t max_length = argc > 1 ? strtoul(argv[1], NULL, 10) : 65536;
+    size_t flush_mib = argc > 2 ? strtoul(argv[2], NULL, 10) : 64;
+    size_t lengths[] = { 16, 1024, 65536, 1048576 };
+
+    flush_size = flush_mib << 20;
+    flush_buf = (unsigned char *)calloc(flush_size ? flush_size : 1, 1);
+    if (!flush_buf) return 1;
+
+    printf("{\n  \"benchmark\": \"ops\",\n  \"reps\": %d,\n  \"mid_ops\": %d,\n"
+           "  \"flush_bytes\": %zu,\n  \"results\": [\n", REPS, MID_OPS, flush_size);
+    for (int cold = 0; cold < 2; cold++)
+    {
+        for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+        {
+            if (lengths[i] > max_length) break;
+            run_payload<P8>(lengths[i], cold);
+            run_payload<P64>(lengths[i], cold);
+            run_payload<P256>(lengths[i], cold);
+        }
+    }
+    printf("\n  ]\n}\n");
+
+    free(flush_buf);
+    return 0;
+}
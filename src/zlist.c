@@ -10,6 +10,7 @@
  * • O(1) push/pop front/back, insert_after, splice
  * • Full bidirectional iterators
  * • C++ z_list::list<T> with RAII and STL-compatible interface
+ * • C++ lists of unregistered types through a pure template fallback
  * • Optional short names via ZLIST_SHORT_NAMES
  * • Automatic type registration via z_registry.h
  * • Allocation failure returns Z_ENOMEM (fast path)
@@ -30,6 +31,101 @@
 #include <stdbool.h>
 #include <string.h>
 
+#if defined(ZLIST_ENABLE_IO) && !defined(__cplusplus)
+#   include <stdint.h>
+#   include <errno.h>
+#   include <limits.h>
+#   include <unistd.h>
+#   include <sys/uio.h>
+#   include <sys/socket.h>
+#endif
+
+// Offset-linked region lists, see ZLIST_ENABLE_MMAP and ZLIST_ENABLE_SHM.
+#if (defined(ZLIST_ENABLE_MMAP) || defined(ZLIST_ENABLE_SHM)) && !defined(__cplusplus)
+#   define ZLIST_HAS_REGION 1
+#   include <stdint.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#else
+#   define ZLIST_HAS_REGION 0
+#endif
+
+#if defined(ZLIST_ENABLE_SHM) && !defined(__cplusplus)
+#   include <errno.h>
+#   include <time.h>
+#   include <pthread.h>
+#endif
+
+#if defined(ZLIST_ENABLE_JOURNAL) && !defined(__cplusplus)
+#   include <stdint.h>
+#   include <errno.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/stat.h>
+#endif
+
+#if defined(ZLIST_ENABLE_SNAPSHOT) && !defined(__cplusplus)
+#   include <stdint.h>
+#endif
+
+#if defined(ZLIST_ENABLE_URING) && !defined(__cplusplus)
+#   include <stdint.h>
+#   include <errno.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#   include <linux/io_uring.h>
+#endif
+
+#if defined(ZLIST_ENABLE_TIERED) && !defined(__cplusplus)
+#   include <stdint.h>
+#endif
+
+#if defined(ZLIST_ENABLE_STATS) && !defined(__cplusplus)
+#   include <stdint.h>
+#   include <stdio.h>
+#   include <time.h>
+#endif
+
+#if defined(ZLIST_ENABLE_MEMORY_REPORT) && !defined(__cplusplus)
+#   include <stdint.h>
+#   include <stdio.h>
+#endif
+
+#if defined(ZLIST_ENABLE_PROBES) && !defined(ZLIST_PROBE)
+#   if defined(__has_include) && __has_include(<sys/sdt.h>)
+#       include <sys/sdt.h>
+#       define ZLIST_HAS_SDT 1
+#   endif
+#endif
+
+/* * Static probes (opt-in). With ZLIST_ENABLE_PROBES every mutator fires
+ * ZLIST_PROBE(op, list, type, length) after it has changed the list, where 'op'
+ * is a bare name (push_back, pop_front, splice, ...) and 'type' the registered
+ * Name as a string. By default the probe is a USDT marker from <sys/sdt.h>
+ * (provider "zlist"), which costs a nop until perf or bpftrace attaches to it.
+ * Without that header, or without the flag, probes compile to nothing. Define
+ * ZLIST_PROBE before including the header to route them elsewhere. The C++
+ * wrapper fires the same probes for types without a registered Name, with "generic"
+ * as the type.
+ */
+#if defined(ZLIST_ENABLE_PROBES)
+    #ifndef ZLIST_PROBE
+        #if defined(ZLIST_HAS_SDT)
+            #define ZLIST_PROBE(op, l, type, len) DTRACE_PROBE3(zlist, op, l, type, len)
+        #else
+            #define ZLIST_PROBE(op, l, type, len) ((void)0)
+        #endif
+    #endif
+    #define ZLIST_P_FIRE(op, Name, l)      ZLIST_PROBE(op, (l), #Name, (l)->length)
+    #define ZLIST_P_FIRE_GENERIC(op, l)    ZLIST_PROBE(op, (l), "generic", (l)->length)
+#else
+#   define ZLIST_P_FIRE(op, Name, l)       ((void)0)
+#   define ZLIST_P_FIRE_GENERIC(op, l)     ((void)0)
+#endif
+
 #if defined(__has_include) && __has_include("zerror.h")
     #include "zerror.h"
     #define Z_HAS_ZERROR 1
@@ -46,377 +142,5624 @@
 #include <iterator>
 #include <utility>
 #include <type_traits>
+#include <memory>
 #include <new>
 
+// MSVC only reports the real language level through _MSVC_LANG.
+#if defined(_MSVC_LANG)
+#   define ZLIST_CPLUSPLUS _MSVC_LANG
+#else
+#   define ZLIST_CPLUSPLUS __cplusplus
+#endif
+
+#if ZLIST_CPLUSPLUS >= 201703L && defined(__has_include)
+#   if __has_include(<memory_resource>)
+#       include <memory_resource>
+#       define ZLIST_HAS_PMR 1
+#   endif
+#endif
+
+#ifndef ZLIST_HAS_PMR
+#   define ZLIST_HAS_PMR 0
+#endif
+
+#if ZLIST_CPLUSPLUS >= 202002L && defined(__has_include)
+#   if __has_include(<ranges>)
+#       include <ranges>
+#       if defined(__cpp_lib_ranges)
+#           define ZLIST_HAS_RANGES 1
+#       endif
+#   endif
+#endif
+
+#ifndef ZLIST_HAS_RANGES
+#   define ZLIST_HAS_RANGES 0
+#endif
+
+#if ZLIST_CPLUSPLUS >= 202002L && defined(__has_include) && defined(__cpp_impl_coroutine)
+#   if __has_include(<coroutine>)
+#       include <coroutine>
+#       include <exception>
+#       define ZLIST_HAS_COROUTINES 1
+#   endif
+#endif
+
+#ifndef ZLIST_HAS_COROUTINES
+#   define ZLIST_HAS_COROUTINES 0
+#endif
+
+// Parallel algorithms are opt-in: they pull in <thread> and need -pthread.
+#if defined(ZLIST_ENABLE_PARALLEL) && ZLIST_CPLUSPLUS >= 201703L && defined(__has_include)
+#   if __has_include(<execution>)
+#       include <execution>
+#       include <thread>
+#       include <mutex>
+#       include <condition_variable>
+#       include <functional>
+#       include <exception>
+#       include <deque>
+#       include <vector>
+#       define ZLIST_HAS_PARALLEL 1
+#   endif
+#endif
+
+#ifndef ZLIST_HAS_PARALLEL
+#   define ZLIST_HAS_PARALLEL 0
+#endif
+
+// Minimum elements per parallel segment.
+#ifndef ZLIST_PARALLEL_GRAIN
+#   define ZLIST_PARALLEL_GRAIN 1024
+#endif
+
+// Threads in the parallel pool, caller included. 0 = hardware concurrency.
+#ifndef ZLIST_PARALLEL_THREADS
+#   define ZLIST_PARALLEL_THREADS 0
+#endif
+
+/* * Opt-in iterator debugging: each list tracks the iterators it handed out and
+ * marks the ones whose element is erased, so using them fails loudly instead of
+ * reading freed memory. Without the macro iterators stay two raw pointers.
+ */
+#ifdef ZLIST_DEBUG_ITERATORS
+#   include <cstdio>
+#   include <cstdlib>
+#   ifndef ZLIST_ITERATOR_FAIL
+#       define ZLIST_ITERATOR_FAIL(msg) (std::fprintf(stderr, "zlist: %s\n", msg), std::abort())
+#   endif
+#endif
+
+/* * [[clang::trivial_abi]] lets a list be passed in registers and relocated by
+ * the compiler. Only libc++ has a trivially copyable std::allocator, which the
+ * attribute requires of every base, so it is limited to that combination.
+ * Debug iterators point back at their list, which rules it out.
+ */
+#if !defined(ZLIST_TRIVIAL_ABI) && !defined(ZLIST_DEBUG_ITERATORS)
+#   if defined(__clang__) && defined(_LIBCPP_VERSION) && defined(__has_cpp_attribute)
+#       if __has_cpp_attribute(clang::trivial_abi)
+#           define ZLIST_TRIVIAL_ABI [[clang::trivial_abi]]
+#       endif
+#   endif
+#endif
+
+#ifndef ZLIST_TRIVIAL_ABI
+#   define ZLIST_TRIVIAL_ABI
+#endif
+
 namespace z_list
 {
     // Forward declarations.
-    template <typename T> struct list;
+    template <typename T, typename Allocator = std::allocator<T>> struct list;
     template <typename T> class list_iterator;
 
-    // Traits struct.
-    template <typename T>
-    struct traits
+    namespace detail
     {
-        static_assert(0 == sizeof(T), "No zlist implementation registered for this type.");
-    };
+        // Same layout as zlist_node_##Name / zlist_##Name from ZLIST_GENERATE_IMPL.
+        template <typename T>
+        struct generic_node
+        {
+            generic_node *prev;
+            generic_node *next;
+            T value;
+        };
 
+        template <typename T>
+        struct generic_list
+        {
+            generic_node<T> *head;
+            generic_node<T> *tail;
+            size_t length;
+        };
+    } // namespace detail
+
+    /* * Traits struct.
+     * Registered types specialize it with the generated C functions (see
+     * ZLIST_CPP_TRAITS). Any other type gets this pure template version, which
+     * mirrors ZLIST_GENERATE_IMPL node for node, so z_list::list<T> works for
+     * arbitrary T without REGISTER_ZLIST_TYPES. Of the generator's hooks only the
+     * probes apply here; journal, snapshots, stats and the rest are C-only.
+     */
     template <typename T>
-    class list_iterator
+    struct traits
     {
-    public:
-        using value_type = T;
-        using reference = T&;
-        using pointer = T*;
-        using difference_type = ptrdiff_t;
-        using iterator_category = std::bidirectional_iterator_tag;
-
-        // Use traits to get the underlying C types.
-        using Traits = traits<typename std::remove_const<T>::type>;
-        using CNode = typename Traits::node_type;
-        using CList = typename Traits::list_type;
+        using list_type = detail::generic_list<T>;
+        using node_type = detail::generic_node<T>;
 
-        explicit list_iterator(const CList* l, CNode *p) : list_ptr(l), current(p) {}
-
-        reference operator*() const 
-        { 
-            return current->value; 
+        static node_type *create_node(const T &val)
+        {
+            try 
+            {
+                node_type *n = new node_type;
+                n->prev = nullptr;
+                n->next = nullptr;
+                n->value = val;
+                return n;
+            } 
+            catch (...) 
+            { 
+                return nullptr; 
+            }
         }
 
-        pointer operator->() const 
-        { 
-            return &current->value; 
+        static void free_node(node_type *n)
+        {
+            delete n;
         }
 
-        bool operator==(const list_iterator &other) const 
-        { 
-            return current == other.current; 
+        static list_type init()
+        {
+            list_type l = { nullptr, nullptr, 0 };
+            return l;
         }
 
-        bool operator!=(const list_iterator &other) const 
-        { 
-            return current != other.current; 
+        static bool is_empty(const list_type *l)
+        {
+            return l->head == nullptr;
         }
 
-        list_iterator &operator++() 
+        static void reverse(list_type *l)
         {
-            if (current) 
+            node_type *curr = l->head;
+            node_type *temp = nullptr;
+            while (curr)
             {
-                current = current->next; 
+                temp = curr->prev;
+                curr->prev = curr->next;
+                curr->next = temp;
+                curr = curr->prev;
             }
-            return *this; 
+            if (temp)
+            {
+                l->tail = l->head;
+                l->head = temp->prev;
+            }
+            ZLIST_P_FIRE_GENERIC(reverse, l);
         }
 
-        list_iterator operator++(int) 
+        static node_type *unlink(list_type *l, node_type *n)
         {
-            list_iterator temp = *this; 
-            if (current)
-            {
-                current = current->next;
-            }
-            return temp; 
+            if (n->prev) n->prev->next = n->next;
+            else l->head = n->next;
+            if (n->next) n->next->prev = n->prev;
+            else l->tail = n->prev;
+            n->prev = n->next = nullptr;
+            l->length--;
+            return n;
         }
 
-        list_iterator &operator--() 
-        { 
-            if (nullptr == current)
-            {
-                current = list_ptr->tail;
-            }
-            else
-            {
-                current = current->prev; 
-            }
-            return *this; 
+        static node_type *detach(list_type *l, node_type *n)
+        {
+            if (!n) return nullptr;
+            unlink(l, n);
+            ZLIST_P_FIRE_GENERIC(detach, l);
+            return n;
         }
 
-        list_iterator operator--(int) 
-        { 
-            list_iterator temp = *this;
-            if (nullptr == current)
+        static void link(list_type *l, node_type *pos, node_type *n)
+        {
+            if (!pos)
             {
-                current = list_ptr->tail;
+                n->prev = l->tail;
+                n->next = nullptr;
+                if (l->tail) l->tail->next = n;
+                else l->head = n;
+                l->tail = n;
             }
             else
             {
-                current = current->prev;
+                n->prev = pos->prev;
+                n->next = pos;
+                if (pos->prev) pos->prev->next = n;
+                else l->head = n;
+                pos->prev = n;
             }
-            return temp; 
+            l->length++;
         }
 
-    private:
-        const CList* list_ptr; 
-        CNode *current;
-        friend struct list<typename std::remove_const<T>::type>;
-    };
-
-    template <typename T>
-    struct list
-    {
-        using Traits = traits<T>;
-        using c_list = typename Traits::list_type;
-        using c_node = typename Traits::node_type;
+        static void link_before(list_type *l, node_type *pos, node_type *n)
+        {
+            link(l, pos, n);
+            ZLIST_P_FIRE_GENERIC(link, l);
+        }
 
-        using iterator = list_iterator<T>;
-        using const_iterator = list_iterator<const T>;
+        static int push_back(list_type *l, T val)
+        {
+            node_type *n = create_node(val);
+            if (!n) return Z_ENOMEM;
+            link(l, nullptr, n);
+            ZLIST_P_FIRE_GENERIC(push_back, l);
+            return Z_OK;
+        }
 
-        c_list inner;
+        static int push_front(list_type *l, T val)
+        {
+            node_type *n = create_node(val);
+            if (!n) return Z_ENOMEM;
+            link(l, l->head, n);
+            ZLIST_P_FIRE_GENERIC(push_front, l);
+            return Z_OK;
+        }
 
-        list() : inner(Traits::init()) {}
+        static int insert_after(list_type *l, node_type *prev_node, T val)
+        {
+            if (!prev_node) return push_front(l, val);
+            node_type *n = create_node(val);
+            if (!n) return Z_ENOMEM;
+            link(l, prev_node->next, n);
+            ZLIST_P_FIRE_GENERIC(insert_after, l);
+            return Z_OK;
+        }
 
-        list(std::initializer_list<T> init) : inner(Traits::init())
+        static int insert_before(list_type *l, node_type *next_node, T val)
         {
-            for (const auto &item : init) 
-            {
-                push_back(item);
-            }
+            node_type *n = create_node(val);
+            if (!n) return Z_ENOMEM;
+            link_before(l, next_node, n);
+            return Z_OK;
         }
 
-        list(const list &other) : inner(Traits::init())
+        static void pop_back(list_type *l)
         {
-            for (const auto &item : other)
-            {
-                push_back(item);
-            }
+            if (!l->tail) return;
+            free_node(unlink(l, l->tail));
+            ZLIST_P_FIRE_GENERIC(pop_back, l);
         }
 
-        list(list &&other) noexcept : inner(other.inner)
+        static void pop_front(list_type *l)
         {
-            other.inner = Traits::init();
+            if (!l->head) return;
+            free_node(unlink(l, l->head));
+            ZLIST_P_FIRE_GENERIC(pop_front, l);
         }
 
-        ~list()
+        static void remove_node(list_type *l, node_type *n)
         {
-            Traits::clear(&inner);
+            if (!n) return;
+            free_node(unlink(l, n));
+            ZLIST_P_FIRE_GENERIC(remove, l);
         }
 
-        list &operator=(const list &other)
+        static void clear(list_type *l)
         {
-            if (&other != this) 
+            node_type *curr = l->head;
+            while (curr)
             {
-                Traits::clear(&inner);
-                inner = Traits::init();
-                for (const auto &item : other)
-                {
-                    push_back(item);
-                }
+                node_type *next = curr->next;
+                free_node(curr);
+                curr = next;
             }
-            return *this;
+            l->head = l->tail = nullptr;
+            l->length = 0;
+            ZLIST_P_FIRE_GENERIC(clear, l);
         }
 
-        list& operator=(list &&other) noexcept
+        static void splice(list_type *dest, list_type *src)
         {
-            if (this != &other)
+            if (dest == src || !src->head) return;
+            if (!dest->head)
             {
-                Traits::clear(&inner);
-                inner = other.inner;
-                other.inner = Traits::init();
+                *dest = *src;
             }
-            return *this;
+            else
+            {
+                dest->tail->next = src->head;
+                src->head->prev = dest->tail;
+                dest->tail = src->tail;
+                dest->length += src->length;
+            }
+            src->head = src->tail = nullptr;
+            src->length = 0;
+            ZLIST_P_FIRE_GENERIC(splice, dest);
         }
 
-        size_t size() const
-        { 
-            return inner.length;
-        }
-        
-        bool empty() const
+        static node_type *at(list_type *l, size_t index)
         {
-            return Traits::is_empty(&inner);
-        }
-
-        T &front() 
-        { 
-            if (empty()) throw std::out_of_range("list::front");
-            return inner.head->value; 
-        }
-
-        const T &front() const 
-        { 
-            if (empty()) throw std::out_of_range("list::front");
-            return inner.head->value; 
+            if (index >= l->length) return nullptr;
+            node_type *curr = l->head;
+            while (index-- > 0) curr = curr->next;
+            return curr;
         }
 
-        T &back() 
-        { 
-            if (empty()) throw std::out_of_range("list::back");
-            return inner.tail->value; 
+        static node_type *head(list_type *l)
+        {
+            return l->head;
         }
 
-        const T &back() const 
-        { 
-            if (empty()) throw std::out_of_range("list::back");
-            return inner.tail->value; 
+        static node_type *tail(list_type *l)
+        {
+            return l->tail;
         }
+    };
 
-        void push_back(const T &val) 
-        { 
-            if (Z_OK != Traits::push_back(&inner, val))
+    namespace detail
+    {
+        template <typename T>
+        T *relocate_impl(T *first, T *last, T *dest, std::true_type) noexcept
+        {
+            size_t n = static_cast<size_t>(last - first);
+            if (n > 0)
             {
-                throw std::bad_alloc();
+                memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
             }
+            return dest + n;
         }
-        
-        void push_front(const T &val) 
-        { 
-            if (Z_OK != Traits::push_front(&inner, val))
+
+        template <typename T>
+        T *relocate_impl(T *first, T *last, T *dest, std::false_type)
+        {
+            for (; first != last; ++first, ++dest)
             {
-                throw std::bad_alloc();
+                ::new (static_cast<void*>(dest)) T(std::move(*first));
+                first->~T();
             }
+            return dest;
         }
 
-        void pop_back() 
-        { 
-            if (empty()) throw std::out_of_range("list::pop_back");
-            Traits::pop_back(&inner); 
-        }
-
-        void pop_front() 
-        { 
-            if (empty()) throw std::out_of_range("list::pop_front");
-            Traits::pop_front(&inner); 
-        }
-
-        void clear()
-        { 
-            Traits::clear(&inner);
-        }
-
-        void reverse()
+        struct value_less
         {
-            Traits::reverse(&inner);
-        }
+            template <typename V>
+            bool operator()(const V &a, const V &b) const { return a < b; }
+        };
 
-        iterator insert_after(iterator pos, const T &val)
+        // Merges two null-terminated 'next' chains. Ties keep 'a' first (stable).
+        template <typename Node, typename Compare>
+        Node *merge_chains(Node *a, Node *b, Compare &comp)
         {
-            c_node *prev_node = pos.current;
-            if (Z_OK != Traits::insert_after(&inner, prev_node, val)) 
+            Node *result = nullptr;
+            Node **tail = &result;
+            while (a && b)
             {
-                 throw std::bad_alloc();
+                if (comp(b->value, a->value))
+                {
+                    *tail = b;
+                    b = b->next;
+                }
+                else
+                {
+                    *tail = a;
+                    a = a->next;
+                }
+                tail = &(*tail)->next;
             }
-            return iterator(&inner, prev_node ? prev_node->next : inner.head);
+            *tail = a ? a : b;
+            return result;
         }
 
-        iterator erase(iterator pos)
+        /* * Bottom-up merge sort over a 'next' chain: bins[i] holds a sorted run of
+         * 2^i nodes, like a binary counter. O(N log N), stable, no allocation.
+         * 'prev' links are left stale, see relink_chain().
+         */
+        template <typename Node, typename Compare>
+        Node *sort_chain(Node *head, Compare &comp)
         {
-            if (nullptr == pos.current)
+            Node *bins[64] = { nullptr };
+            while (head)
             {
-                throw std::out_of_range("list::erase on end()");
+                Node *run = head;
+                head = head->next;
+                run->next = nullptr;
+                size_t i = 0;
+                for (; i < 63 && bins[i]; i++)
+                {
+                    run = merge_chains(bins[i], run, comp);
+                    bins[i] = nullptr;
+                }
+                bins[i] = merge_chains(bins[i], run, comp);
             }
-            c_node *to_remove = pos.current;
-            c_node *next_node = to_remove->next;
-            Traits::remove_node(&inner, to_remove);
-            return iterator(&inner, next_node);
+            Node *result = nullptr;
+            for (size_t i = 0; i < 64; i++)
+            {
+                if (bins[i]) result = merge_chains(bins[i], result, comp);
+            }
+            return result;
         }
 
-        void splice(list &&source)
+        // Installs a 'next' chain as the list contents and repairs 'prev'/tail.
+        template <typename List, typename Node>
+        void relink_chain(List *l, Node *head)
         {
-            Traits::splice(&inner, &source.inner);
+            Node *prev = nullptr;
+            l->head = head;
+            for (Node *curr = head; curr; curr = curr->next)
+            {
+                curr->prev = prev;
+                prev = curr;
+            }
+            l->tail = prev;
         }
 
-        iterator begin() { return iterator(&inner, inner.head); }
-        const_iterator begin() const { return const_iterator(&inner, inner.head); }
-        const_iterator cbegin() const { return const_iterator(&inner, inner.head); }
-        iterator end() { return iterator(&inner, nullptr); }
-        const_iterator end() const { return const_iterator(&inner, nullptr); }
-        const_iterator cend() const { return const_iterator(&inner, nullptr); }
-    };
+        /* * Trait: do nodes from this allocator live inside the container object
+         * that owns it (inline_allocator)? Such nodes can never leave that object,
+         * so list moves, swaps and extracts them element-wise when allocators differ.
+         */
+        template <typename A>
+        struct is_object_bound : std::false_type {};
 
-    template <typename T>
-    using list_T = list<T>;
-} // namespace z_list
+        // Empty-base holder so stateless allocators do not grow the list object.
+        template <typename A, bool = std::is_empty<A>::value>
+        struct alloc_holder : private A
+        {
+            alloc_holder() : A() {}
+            explicit alloc_holder(const A &a) : A(a) {}
+            explicit alloc_holder(A &&a) : A(std::move(a)) {}
+
+            A &get_alloc() noexcept { return *this; }
+            const A &get_alloc() const noexcept { return *this; }
+        };
+
+        template <typename A>
+        struct alloc_holder<A, false>
+        {
+            alloc_holder() : alloc() {}
+            explicit alloc_holder(const A &a) : alloc(a) {}
+            explicit alloc_holder(A &&a) : alloc(std::move(a)) {}
+
+            A &get_alloc() noexcept { return alloc; }
+            const A &get_alloc() const noexcept { return alloc; }
+
+        private:
+            A alloc;
+        };
+
+#ifdef ZLIST_DEBUG_ITERATORS
+        class iterator_registry;
+
+        // State every debug iterator carries: its owning list and the node it is on.
+        class debug_iterator_base
+        {
+        protected:
+            // Points a re-registered iterator at its new list (see splice()).
+            using rehome_fn = void (*)(debug_iterator_base *, const void *);
+
+            explicit debug_iterator_base(rehome_fn fn) noexcept
+                : owner(nullptr), prev_tracked(nullptr), next_tracked(nullptr),
+                  node(nullptr), invalidated(false), rehome(fn) {}
+
+            debug_iterator_base(const debug_iterator_base &other) noexcept
+                : owner(nullptr), prev_tracked(nullptr), next_tracked(nullptr),
+                  node(other.node), invalidated(other.invalidated), rehome(other.rehome)
+            {
+                attach(other.owner);
+            }
+
+            debug_iterator_base &operator=(const debug_iterator_base &other) noexcept
+            {
+                if (this != &other)
+                {
+                    detach();
+                    node = other.node;
+                    invalidated = other.invalidated;
+                    rehome = other.rehome;
+                    attach(other.owner);
+                }
+                return *this;
+            }
+
+            ~debug_iterator_base()
+            {
+                detach();
+            }
+
+            inline void attach(iterator_registry *r) noexcept;
+            inline void detach() noexcept;
+
+            void check_valid(const char *msg) const
+            {
+                if (invalidated) ZLIST_ITERATOR_FAIL(msg);
+            }
+
+            void check_owner(const iterator_registry *r, const char *msg) const
+            {
+                check_valid(msg);
+                if (owner && owner != r) ZLIST_ITERATOR_FAIL("iterator belongs to another list");
+            }
+
+            iterator_registry *owner;
+            debug_iterator_base *prev_tracked;
+            debug_iterator_base *next_tracked;
+            const void *node;
+            bool invalidated;
+            rehome_fn rehome;
+
+            friend class iterator_registry;
+        };
+
+        // Intrusive list of the live iterators handed out by one list.
+        class iterator_registry
+        {
+        public:
+            iterator_registry() noexcept : first(nullptr) {}
+
+            iterator_registry(const iterator_registry &) = delete;
+            iterator_registry &operator=(const iterator_registry &) = delete;
+
+            // Iterators that outlive their list, end() included, can no longer be used.
+            ~iterator_registry()
+            {
+                while (first)
+                {
+                    drop(first);
+                }
+            }
+
+            // Called before 'node' is freed or leaves the list.
+            void invalidate(const void *node) noexcept
+            {
+                debug_iterator_base *it = first;
+                while (it)
+                {
+                    debug_iterator_base *next = it->next_tracked;
+                    if (it->node == node) drop(it);
+                    it = next;
+                }
+            }
+
+            // Hands iterators on 'node' (every element when null) over to 'dest'.
+            void transfer(iterator_registry &dest, const void *dest_list, const void *node) noexcept
+            {
+                debug_iterator_base *it = first;
+                while (it)
+                {
+                    debug_iterator_base *next = it->next_tracked;
+                    if (it->node && (nullptr == node || it->node == node))
+                    {
+                        unlink(it);
+                        dest.link(it);
+                        it->rehome(it, dest_list);
+                    }
+                    it = next;
+                }
+            }
+
+        private:
+            debug_iterator_base *first;
+
+            // Temporaries unregister in their destructor, which GCC 12+ cannot see.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wdangling-pointer"
+#endif
+            void link(debug_iterator_base *it) noexcept
+            {
+                it->owner = this;
+                it->prev_tracked = nullptr;
+                it->next_tracked = first;
+                if (first) first->prev_tracked = it;
+                first = it;
+            }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12
+#   pragma GCC diagnostic pop
+#endif
+
+            void unlink(debug_iterator_base *it) noexcept
+            {
+                if (it->prev_tracked) it->prev_tracked->next_tracked = it->next_tracked;
+                else first = it->next_tracked;
+                if (it->next_tracked) it->next_tracked->prev_tracked = it->prev_tracked;
+                it->owner = nullptr;
+                it->prev_tracked = it->next_tracked = nullptr;
+            }
+
+            void drop(debug_iterator_base *it) noexcept
+            {
+                unlink(it);
+                it->invalidated = true;
+            }
+
+            friend class debug_iterator_base;
+        };
+
+        void debug_iterator_base::attach(iterator_registry *r) noexcept
+        {
+            if (r) r->link(this);
+        }
+
+        void debug_iterator_base::detach() noexcept
+        {
+            if (owner) owner->unlink(this);
+        }
+#endif
+    } // namespace detail
+
+    template <typename T>
+    class list_iterator
+#ifdef ZLIST_DEBUG_ITERATORS
+        : private detail::debug_iterator_base
+#endif
+    {
+    public:
+        using value_type = typename std::remove_const<T>::type;
+        using reference = T&;
+        using pointer = T*;
+        using difference_type = ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        // Use traits to get the underlying C types.
+        using Traits = traits<typename std::remove_const<T>::type>;
+        using CNode = typename Traits::node_type;
+        using CList = typename Traits::list_type;
+
+#ifdef ZLIST_DEBUG_ITERATORS
+        list_iterator() noexcept : debug_iterator_base(&rehome_to), list_ptr(nullptr), current(nullptr) {}
+
+        explicit list_iterator(const CList* l, CNode *p) noexcept 
+            : debug_iterator_base(&rehome_to), list_ptr(l), current(p)
+        {
+            node = p;
+        }
+
+        list_iterator(const CList* l, CNode *p, detail::iterator_registry *r) noexcept : list_iterator(l, p)
+        {
+            attach(r);
+        }
+#else
+        list_iterator() noexcept : list_ptr(nullptr), current(nullptr) {}
+
+        explicit list_iterator(const CList* l, CNode *p) noexcept : list_ptr(l), current(p) {}
+#endif
+
+        reference operator*() const 
+        { 
+            check_deref();
+            return current->value; 
+        }
+
+        pointer operator->() const 
+        { 
+            check_deref();
+            return &current->value; 
+        }
+
+        bool operator==(const list_iterator &other) const 
+        { 
+            return current == other.current; 
+        }
+
+        bool operator!=(const list_iterator &other) const 
+        { 
+            return current != other.current; 
+        }
+
+#if ZLIST_HAS_RANGES
+        // Sentinel end: a forward walk only tests the node pointer, like zlist_foreach.
+        bool operator==(std::default_sentinel_t) const noexcept
+        {
+            return nullptr == current;
+        }
+#endif
+
+        list_iterator &operator++() 
+        {
+            check_step();
+            if (current) 
+            {
+                current = current->next; 
+            }
+            track();
+            return *this; 
+        }
+
+        list_iterator operator++(int) 
+        {
+            list_iterator temp = *this; 
+            ++*this;
+            return temp; 
+        }
+
+        list_iterator &operator--() 
+        { 
+            check_step();
+            if (nullptr == current)
+            {
+                current = list_ptr->tail;
+            }
+            else
+            {
+                current = current->prev; 
+            }
+            track();
+            return *this; 
+        }
+
+        list_iterator operator--(int) 
+        { 
+            list_iterator temp = *this;
+            --*this;
+            return temp; 
+        }
+
+    private:
+        const CList* list_ptr; 
+        CNode *current;
+        template <typename, typename> friend struct list;
+
+#ifdef ZLIST_DEBUG_ITERATORS
+        static void rehome_to(detail::debug_iterator_base *base, const void *l) noexcept
+        {
+            static_cast<list_iterator*>(base)->list_ptr = static_cast<const CList*>(l);
+        }
+
+        void check_deref() const
+        {
+            check_valid("dereferencing an invalidated iterator");
+            if (nullptr == current) ZLIST_ITERATOR_FAIL("dereferencing end()");
+        }
+
+        void check_step() const
+        {
+            check_valid("moving an invalidated iterator");
+        }
+
+        void track() noexcept
+        {
+            node = current;
+        }
+#else
+        void check_deref() const noexcept {}
+        void check_step() const noexcept {}
+        void track() noexcept {}
+#endif
+    };
+
+    /* * Owning handle to a node extracted from a list. The node keeps its memory
+     * while it travels between lists with the same allocator, so moving an element
+     * with extract() + insert() never allocates.
+     */
+    template <typename T, typename Allocator>
+    class list_node_handle
+    {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+
+        list_node_handle() noexcept : node(nullptr) {}
+
+        list_node_handle(list_node_handle &&other) noexcept : node(other.node)
+        {
+            if (node)
+            {
+                ::new (static_cast<void*>(alloc_storage)) node_allocator(std::move(other.alloc()));
+                other.reset();
+            }
+        }
+
+        list_node_handle &operator=(list_node_handle &&other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy();
+                if (other.node)
+                {
+                    node = other.node;
+                    ::new (static_cast<void*>(alloc_storage)) node_allocator(std::move(other.alloc()));
+                    other.reset();
+                }
+            }
+            return *this;
+        }
+
+        list_node_handle(const list_node_handle &) = delete;
+        list_node_handle &operator=(const list_node_handle &) = delete;
+
+        ~list_node_handle()
+        {
+            destroy();
+        }
+
+        bool empty() const noexcept { return nullptr == node; }
+        explicit operator bool() const noexcept { return nullptr != node; }
+
+        T &value() const 
+        {
+            if (empty()) throw std::out_of_range("list_node_handle::value");
+            return node->value;
+        }
+
+        allocator_type get_allocator() const
+        {
+            if (empty()) throw std::out_of_range("list_node_handle::get_allocator");
+            return allocator_type(alloc());
+        }
+
+    private:
+        using c_node = typename traits<T>::node_type;
+        using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<c_node>;
+        using node_alloc_traits = std::allocator_traits<node_allocator>;
+
+        c_node *node;
+        alignas(node_allocator) unsigned char alloc_storage[sizeof(node_allocator)];
+
+        list_node_handle(c_node *n, const node_allocator &a) : node(n)
+        {
+            ::new (static_cast<void*>(alloc_storage)) node_allocator(a);
+        }
+
+        node_allocator &alloc() const
+        {
+            return *reinterpret_cast<node_allocator*>(const_cast<unsigned char*>(alloc_storage));
+        }
+
+        // Gives up ownership of the node without freeing it.
+        c_node *release()
+        {
+            c_node *n = node;
+            reset();
+            return n;
+        }
+
+        void reset()
+        {
+            alloc().~node_allocator();
+            node = nullptr;
+        }
+
+        void destroy()
+        {
+            if (node)
+            {
+                node_alloc_traits::destroy(alloc(), std::addressof(node->value));
+                node_alloc_traits::deallocate(alloc(), node, 1);
+                reset();
+            }
+        }
+
+        template <typename, typename> friend struct list;
+    };
+
+#if ZLIST_HAS_RANGES
+    /* * Non-owning view over a list whose end is std::default_sentinel, so loops and
+     * range pipelines (std::views::filter, std::views::transform, ...) stop on a
+     * null node pointer instead of comparing against a second iterator. It holds
+     * the list itself: begin() and size() both read it when called, so the view
+     * always describes the list as it is now.
+     */
+    template <typename T>
+    class list_view : public std::ranges::view_interface<list_view<T>>
+    {
+    public:
+        using iterator = list_iterator<T>;
+        using c_list = typename traits<typename std::remove_const<T>::type>::list_type;
+
+#ifdef ZLIST_DEBUG_ITERATORS
+        list_view() noexcept : list(nullptr), registry(nullptr) {}
+        list_view(const c_list *l, detail::iterator_registry *r) noexcept : list(l), registry(r) {}
+
+        iterator begin() const noexcept
+        {
+            return list ? iterator(list, list->head, registry) : iterator();
+        }
+#else
+        list_view() noexcept : list(nullptr) {}
+        explicit list_view(const c_list *l) noexcept : list(l) {}
+
+        iterator begin() const noexcept
+        {
+            return list ? iterator(list, list->head) : iterator();
+        }
+#endif
+
+        std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+        size_t size() const noexcept { return list ? list->length : 0; }
+
+    private:
+        const c_list *list;
+#ifdef ZLIST_DEBUG_ITERATORS
+        detail::iterator_registry *registry;
+#endif
+    };
+
+    // A range type whose references convert to T.
+    template <typename R, typename T>
+    concept compatible_range = std::ranges::input_range<R> &&
+                               std::convertible_to<std::ranges::range_reference_t<R>, T>;
+#endif
+
+    /* * Nodes are allocated through 'Allocator' rebound to the C node type, so the
+     * list can live entirely inside an arena or a std::pmr resource. The generated
+     * C functions are only used to link and unlink nodes.
+     */
+    template <typename T, typename Allocator>
+    struct ZLIST_TRIVIAL_ABI list : private detail::alloc_holder<
+        typename std::allocator_traits<Allocator>::template rebind_alloc<typename traits<T>::node_type>>
+    {
+        using Traits = traits<T>;
+        using c_list = typename Traits::list_type;
+        using c_node = typename Traits::node_type;
+
+        using allocator_type = Allocator;
+        using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<c_node>;
+        using node_alloc_traits = std::allocator_traits<node_allocator>;
+
+        using iterator = list_iterator<T>;
+        using const_iterator = list_iterator<const T>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        using node_type = list_node_handle<T, Allocator>;
+
+        c_list inner;
+
+        list() : holder(), inner(Traits::init()) {}
+
+        explicit list(const Allocator &alloc) : holder(node_allocator(alloc)), inner(Traits::init()) {}
+
+        list(std::initializer_list<T> init, const Allocator &alloc = Allocator()) 
+            : holder(node_allocator(alloc)), inner(Traits::init())
+        {
+            for (const auto &item : init) 
+            {
+                push_back(item);
+            }
+        }
+
+        list(const list &other) 
+            : holder(node_alloc_traits::select_on_container_copy_construction(other.get_alloc())), 
+              inner(Traits::init())
+        {
+            for (const auto &item : other)
+            {
+                push_back(item);
+            }
+        }
+
+        list(const list &other, const Allocator &alloc) : holder(node_allocator(alloc)), inner(Traits::init())
+        {
+            for (const auto &item : other)
+            {
+                push_back(item);
+            }
+        }
+
+        list(list &&other) noexcept(!object_bound::value)
+            : holder(moved_alloc(other, object_bound())), inner(Traits::init())
+        {
+            if (!object_bound::value || this->get_alloc() == other.get_alloc())
+            {
+                inner = other.inner;
+                other.inner = Traits::init();
+                other.adopt_iterators_into(*this);
+            }
+            else
+            {
+                move_elements_from(other);
+            }
+        }
+
+        list(list &&other, const Allocator &alloc) : holder(node_allocator(alloc)), inner(Traits::init())
+        {
+            if (this->get_alloc() == other.get_alloc())
+            {
+                inner = other.inner;
+                other.inner = Traits::init();
+                other.adopt_iterators_into(*this);
+            }
+            else
+            {
+                move_elements_from(other);
+            }
+        }
+
+        ~list()
+        {
+            clear();
+        }
+
+        list &operator=(const list &other)
+        {
+            if (&other != this) 
+            {
+                clear();
+                copy_alloc(other, typename node_alloc_traits::propagate_on_container_copy_assignment());
+                for (const auto &item : other)
+                {
+                    push_back(item);
+                }
+            }
+            return *this;
+        }
+
+        list& operator=(list &&other) noexcept(node_alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            if (this != &other)
+            {
+                clear();
+                move_assign(other, typename node_alloc_traits::propagate_on_container_move_assignment());
+            }
+            return *this;
+        }
+
+        list &operator=(std::initializer_list<T> init)
+        {
+            assign(init.begin(), init.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return allocator_type(this->get_alloc());
+        }
+
+        // Overwrites existing nodes in place, then trims or extends the tail.
+        void assign(size_t count, const T &val)
+        {
+            c_node *curr = inner.head;
+            for (; curr && count > 0; curr = curr->next, count--)
+            {
+                curr->value = val;
+            }
+            erase_from(curr);
+            for (; count > 0; count--)
+            {
+                push_back(val);
+            }
+        }
+
+        template <typename InputIt, 
+                  typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        void assign(InputIt first, InputIt last)
+        {
+            c_node *curr = inner.head;
+            for (; curr && first != last; curr = curr->next, ++first)
+            {
+                curr->value = *first;
+            }
+            erase_from(curr);
+            for (; first != last; ++first)
+            {
+                push_back(*first);
+            }
+        }
+
+        void assign(std::initializer_list<T> init)
+        {
+            assign(init.begin(), init.end());
+        }
+
+        // Element-wise (three moves, may throw) for object-bound allocators that differ.
+        void swap(list &other) noexcept(!object_bound::value)
+        {
+            if (object_bound::value && !(this->get_alloc() == other.get_alloc()))
+            {
+                list temp(std::move(other));
+                other = std::move(*this);
+                *this = std::move(temp);
+                return;
+            }
+            swap_alloc(other, typename node_alloc_traits::propagate_on_container_swap());
+            c_list temp = inner;
+            inner = other.inner;
+            other.inner = temp;
+#ifdef ZLIST_DEBUG_ITERATORS
+            detail::iterator_registry parked;
+            iterators.transfer(parked, &other.inner, nullptr);
+            other.iterators.transfer(iterators, &inner, nullptr);
+            parked.transfer(other.iterators, &other.inner, nullptr);
+#endif
+        }
+
+        size_t size() const noexcept
+        { 
+            return inner.length;
+        }
+
+        size_t max_size() const noexcept
+        {
+            return node_alloc_traits::max_size(this->get_alloc());
+        }
+        
+        bool empty() const noexcept
+        {
+            return Traits::is_empty(&inner);
+        }
+
+        T &front() 
+        { 
+            if (empty()) throw std::out_of_range("list::front");
+            return inner.head->value; 
+        }
+
+        const T &front() const 
+        { 
+            if (empty()) throw std::out_of_range("list::front");
+            return inner.head->value; 
+        }
+
+        T &back() 
+        { 
+            if (empty()) throw std::out_of_range("list::back");
+            return inner.tail->value; 
+        }
+
+        const T &back() const 
+        { 
+            if (empty()) throw std::out_of_range("list::back");
+            return inner.tail->value; 
+        }
+
+        void push_back(const T &val) 
+        { 
+            Traits::link_before(&inner, nullptr, create_node(val));
+        }
+
+        void push_back(T &&val) 
+        { 
+            Traits::link_before(&inner, nullptr, create_node(std::move(val)));
+        }
+        
+        void push_front(const T &val) 
+        { 
+            Traits::link_before(&inner, inner.head, create_node(val));
+        }
+
+        void push_front(T &&val) 
+        { 
+            Traits::link_before(&inner, inner.head, create_node(std::move(val)));
+        }
+
+        void pop_back() 
+        { 
+            if (empty()) throw std::out_of_range("list::pop_back");
+            destroy_node(Traits::detach(&inner, inner.tail)); 
+        }
+
+        void pop_front() 
+        { 
+            if (empty()) throw std::out_of_range("list::pop_front");
+            destroy_node(Traits::detach(&inner, inner.head)); 
+        }
+
+        void clear()
+        { 
+            c_node *curr = inner.head;
+            while (curr)
+            {
+                c_node *next = curr->next;
+                destroy_node(curr);
+                curr = next;
+            }
+            inner = Traits::init();
+        }
+
+        void reverse()
+        {
+            Traits::reverse(&inner);
+        }
+
+        // Stable merge sort that only relinks nodes. O(N log N), no allocation.
+        template <typename Compare>
+        void sort(Compare comp)
+        {
+            detail::relink_chain(&inner, detail::sort_chain(inner.head, comp));
+        }
+
+        void sort()
+        {
+            sort(detail::value_less());
+        }
+
+        // Grows with value-initialized (or 'val') elements, shrinks from the tail.
+        void resize(size_t count)
+        {
+            shrink_to(count);
+            while (inner.length < count)
+            {
+                Traits::link_before(&inner, nullptr, create_node());
+            }
+        }
+
+        void resize(size_t count, const T &val)
+        {
+            shrink_to(count);
+            while (inner.length < count)
+            {
+                push_back(val);
+            }
+        }
+
+        // Single pass. Returns the number of removed elements.
+        size_t remove(const T &val)
+        {
+            size_t removed = 0;
+            c_node *self = nullptr;
+            c_node *curr = inner.head;
+            while (curr)
+            {
+                c_node *next = curr->next;
+                if (curr->value == val)
+                {
+                    // 'val' may alias an element, so that node goes last.
+                    if (std::addressof(curr->value) == std::addressof(val))
+                    {
+                        self = curr;
+                    }
+                    else
+                    {
+                        destroy_node(Traits::detach(&inner, curr));
+                    }
+                    removed++;
+                }
+                curr = next;
+            }
+            if (self)
+            {
+                destroy_node(Traits::detach(&inner, self));
+            }
+            return removed;
+        }
+
+        template <typename Predicate>
+        size_t remove_if(Predicate pred)
+        {
+            size_t removed = 0;
+            c_node *curr = inner.head;
+            while (curr)
+            {
+                c_node *next = curr->next;
+                if (pred(curr->value))
+                {
+                    destroy_node(Traits::detach(&inner, curr));
+                    removed++;
+                }
+                curr = next;
+            }
+            return removed;
+        }
+
+        // Inserts before 'pos' and returns an iterator to the new element.
+        iterator insert(iterator pos, const T &val)
+        {
+            check_iterator(pos);
+            c_node *n = create_node(val);
+            Traits::link_before(&inner, pos.current, n);
+            return make_iterator(n);
+        }
+
+        iterator insert(iterator pos, T &&val)
+        {
+            check_iterator(pos);
+            c_node *n = create_node(std::move(val));
+            Traits::link_before(&inner, pos.current, n);
+            return make_iterator(n);
+        }
+
+        // Returns an iterator to the first inserted element, or 'pos' if none.
+        iterator insert(iterator pos, size_t count, const T &val)
+        {
+            iterator first = pos;
+            for (size_t i = 0; i < count; i++)
+            {
+                iterator it = insert(pos, val);
+                if (0 == i) first = it;
+            }
+            return first;
+        }
+
+        template <typename InputIt, 
+                  typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        iterator insert(iterator pos, InputIt first, InputIt last)
+        {
+            iterator result = pos;
+            bool inserted = false;
+            for (; first != last; ++first)
+            {
+                iterator it = insert(pos, *first);
+                if (!inserted)
+                {
+                    result = it;
+                    inserted = true;
+                }
+            }
+            return result;
+        }
+
+        iterator insert(iterator pos, std::initializer_list<T> init)
+        {
+            return insert(pos, init.begin(), init.end());
+        }
+
+        iterator insert_after(iterator pos, const T &val)
+        {
+            check_iterator(pos);
+            c_node *prev_node = pos.current;
+            c_node *n = create_node(val);
+            Traits::link_before(&inner, prev_node ? prev_node->next : inner.head, n);
+            return make_iterator(n);
+        }
+
+        iterator erase(iterator pos)
+        {
+            check_iterator(pos);
+            if (nullptr == pos.current)
+            {
+                throw std::out_of_range("list::erase on end()");
+            }
+            c_node *to_remove = pos.current;
+            c_node *next_node = to_remove->next;
+            destroy_node(Traits::detach(&inner, to_remove));
+            return make_iterator(next_node);
+        }
+
+        // Unlinks the node at 'pos' and hands its ownership to the caller.
+        node_type extract(iterator pos)
+        {
+            check_iterator(pos);
+            if (nullptr == pos.current)
+            {
+                throw std::out_of_range("list::extract on end()");
+            }
+            forget_node(pos.current);
+            return hand_out(Traits::detach(&inner, pos.current), object_bound());
+        }
+
+        // Links the handle's node before 'pos'. Returns end() for an empty handle.
+        iterator insert(iterator pos, node_type &&nh)
+        {
+            check_iterator(pos);
+            if (nh.empty())
+            {
+                return end();
+            }
+            c_node *n = nullptr;
+            if (this->get_alloc() == nh.alloc())
+            {
+                n = nh.release();
+            }
+            else
+            {
+                n = create_node(std::move(nh.node->value));
+                nh.destroy();
+            }
+            Traits::link_before(&inner, pos.current, n);
+            return make_iterator(n);
+        }
+
+        // O(1) when both lists share an allocator, element-wise move otherwise.
+        void splice(list &&source)
+        {
+            if (this->get_alloc() == source.get_alloc())
+            {
+                Traits::splice(&inner, &source.inner);
+                source.adopt_iterators_into(*this);
+            }
+            else
+            {
+                move_elements_from(source);
+            }
+        }
+
+        // Moves the element at 'it' from 'other' to before 'pos'.
+        void splice(iterator pos, list &other, iterator it)
+        {
+            check_iterator(pos);
+            other.check_iterator(it);
+            if (nullptr == it.current)
+            {
+                throw std::out_of_range("list::splice on end()");
+            }
+            if (pos.current == it.current)
+            {
+                return;
+            }
+            c_node *n = it.current;
+            if (this == &other || this->get_alloc() == other.get_alloc())
+            {
+                Traits::link_before(&inner, pos.current, Traits::detach(&other.inner, n));
+#ifdef ZLIST_DEBUG_ITERATORS
+                other.iterators.transfer(iterators, &inner, n);
+#endif
+            }
+            else
+            {
+                Traits::link_before(&inner, pos.current, create_node(std::move(n->value)));
+                other.destroy_node(Traits::detach(&other.inner, n));
+            }
+        }
+
+        void splice(iterator pos, list &&other, iterator it)
+        {
+            splice(pos, other, it);
+        }
+
+        // Moves [first, last) from 'other' to before 'pos'. O(distance).
+        void splice(iterator pos, list &other, iterator first, iterator last)
+        {
+            while (first != last)
+            {
+                iterator next = first;
+                ++next;
+                splice(pos, other, first);
+                first = next;
+            }
+        }
+
+        void splice(iterator pos, list &&other, iterator first, iterator last)
+        {
+            splice(pos, other, first, last);
+        }
+
+        iterator begin() noexcept { return make_iterator(inner.head); }
+        const_iterator begin() const noexcept { return make_iterator(inner.head); }
+        const_iterator cbegin() const noexcept { return make_iterator(inner.head); }
+        iterator end() noexcept { return make_iterator(nullptr); }
+        const_iterator end() const noexcept { return make_iterator(nullptr); }
+        const_iterator cend() const noexcept { return make_iterator(nullptr); }
+
+#if ZLIST_HAS_RANGES
+#ifdef ZLIST_DEBUG_ITERATORS
+        list_view<T> view() noexcept { return list_view<T>(&inner, &iterators); }
+        list_view<const T> view() const noexcept { return list_view<const T>(&inner, &iterators); }
+#else
+        list_view<T> view() noexcept { return list_view<T>(&inner); }
+        list_view<const T> view() const noexcept { return list_view<const T>(&inner); }
+#endif
+
+        template <compatible_range<T> R>
+        void append_range(R &&range)
+        {
+            for (auto &&item : range)
+            {
+                push_back(std::forward<decltype(item)>(item));
+            }
+        }
+
+        template <compatible_range<T> R>
+        void prepend_range(R &&range)
+        {
+            insert_range(begin(), std::forward<R>(range));
+        }
+
+        // Inserts before 'pos'. Returns an iterator to the first inserted element.
+        template <compatible_range<T> R>
+        iterator insert_range(iterator pos, R &&range)
+        {
+            iterator result = pos;
+            bool inserted = false;
+            for (auto &&item : range)
+            {
+                iterator it = insert(pos, std::forward<decltype(item)>(item));
+                if (!inserted)
+                {
+                    result = it;
+                    inserted = true;
+                }
+            }
+            return result;
+        }
+
+        template <compatible_range<T> R>
+        void assign_range(R &&range)
+        {
+            c_node *curr = inner.head;
+            auto it = std::ranges::begin(range);
+            auto last = std::ranges::end(range);
+            for (; curr && it != last; curr = curr->next, ++it)
+            {
+                curr->value = *it;
+            }
+            erase_from(curr);
+            for (; it != last; ++it)
+            {
+                push_back(*it);
+            }
+        }
+#endif
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+    private:
+        using holder = detail::alloc_holder<node_allocator>;
+        using object_bound = detail::is_object_bound<node_allocator>;
+
+#ifdef ZLIST_DEBUG_ITERATORS
+        mutable detail::iterator_registry iterators;
+
+        iterator make_iterator(c_node *n) noexcept 
+        { 
+            return iterator(&inner, n, &iterators); 
+        }
+
+        const_iterator make_iterator(c_node *n) const noexcept 
+        { 
+            return const_iterator(&inner, n, &iterators); 
+        }
+
+        template <typename It>
+        void check_iterator(const It &pos) const
+        {
+            pos.check_owner(&iterators, "using an invalidated iterator");
+        }
+
+        void forget_node(c_node *n) noexcept
+        {
+            iterators.invalidate(n);
+        }
+
+        // Element iterators follow their nodes when the whole chain changes owner.
+        void adopt_iterators_into(list &dest) noexcept
+        {
+            iterators.transfer(dest.iterators, &dest.inner, nullptr);
+        }
+#else
+        iterator make_iterator(c_node *n) noexcept { return iterator(&inner, n); }
+        const_iterator make_iterator(c_node *n) const noexcept { return const_iterator(&inner, n); }
+
+        template <typename It>
+        void check_iterator(const It &) const noexcept {}
+        void forget_node(c_node *) noexcept {}
+        void adopt_iterators_into(list &) noexcept {}
+#endif
+
+        template <typename... Args>
+        c_node *create_node(Args&&... args)
+        {
+            c_node *n = node_alloc_traits::allocate(this->get_alloc(), 1);
+            try
+            {
+                node_alloc_traits::construct(this->get_alloc(), std::addressof(n->value), 
+                                             std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                node_alloc_traits::deallocate(this->get_alloc(), n, 1);
+                throw;
+            }
+            n->prev = nullptr;
+            n->next = nullptr;
+            return n;
+        }
+
+        void destroy_node(c_node *n)
+        {
+            forget_node(n);
+            node_alloc_traits::destroy(this->get_alloc(), std::addressof(n->value));
+            node_alloc_traits::deallocate(this->get_alloc(), n, 1);
+        }
+
+        static node_allocator moved_alloc(list &other, std::false_type) noexcept
+        {
+            return std::move(other.get_alloc());
+        }
+
+        // An object-bound allocator stays with its object; the new list gets a detached one.
+        static node_allocator moved_alloc(list &other, std::true_type)
+        {
+            return node_alloc_traits::select_on_container_copy_construction(other.get_alloc());
+        }
+
+        node_type hand_out(c_node *n, std::false_type) noexcept
+        {
+            return node_type(n, this->get_alloc());
+        }
+
+        // A handle may outlive the list, so a bound node is copied out to a detached one.
+        node_type hand_out(c_node *n, std::true_type)
+        {
+            node_allocator detached = moved_alloc(*this, std::true_type());
+            if (detached == this->get_alloc())
+            {
+                return node_type(n, this->get_alloc());
+            }
+            list heap((allocator_type(detached)));
+            try
+            {
+                heap.push_back(std::move(n->value));
+            }
+            catch (...)
+            {
+                destroy_node(n);
+                throw;
+            }
+            destroy_node(n);
+            return heap.extract(heap.begin());
+        }
+
+        // Used when nodes cannot change owner because the allocators differ.
+        void move_elements_from(list &source)
+        {
+            for (c_node *curr = source.inner.head; curr; curr = curr->next)
+            {
+                push_back(std::move(curr->value));
+            }
+            source.clear();
+        }
+
+        // Frees 'from' and every node after it.
+        void erase_from(c_node *from)
+        {
+            if (nullptr == from)
+            {
+                return;
+            }
+            while (inner.tail != from)
+            {
+                destroy_node(Traits::detach(&inner, inner.tail));
+            }
+            destroy_node(Traits::detach(&inner, from));
+        }
+
+        void shrink_to(size_t count)
+        {
+            while (inner.length > count)
+            {
+                destroy_node(Traits::detach(&inner, inner.tail));
+            }
+        }
+
+        void swap_alloc(list &other, std::true_type) noexcept
+        {
+            using std::swap;
+            swap(this->get_alloc(), other.get_alloc());
+        }
+
+        void swap_alloc(list &, std::false_type) noexcept {}
+
+        void copy_alloc(const list &other, std::true_type)
+        {
+            this->get_alloc() = other.get_alloc();
+        }
+
+        void copy_alloc(const list &, std::false_type) {}
+
+        void move_assign(list &other, std::true_type)
+        {
+            this->get_alloc() = std::move(other.get_alloc());
+            inner = other.inner;
+            other.inner = Traits::init();
+            other.adopt_iterators_into(*this);
+        }
+
+        void move_assign(list &other, std::false_type)
+        {
+            if (this->get_alloc() == other.get_alloc())
+            {
+                inner = other.inner;
+                other.inner = Traits::init();
+                other.adopt_iterators_into(*this);
+            }
+            else
+            {
+                move_elements_from(other);
+            }
+        }
+    };
+
+    template <typename T, typename Allocator>
+    void swap(list<T, Allocator> &a, list<T, Allocator> &b) noexcept(noexcept(a.swap(b)))
+    {
+        a.swap(b);
+    }
+
+    template <typename T>
+    using list_T = list<T>;
+
+    /* * Trait: can a T be moved to new storage with memcpy, leaving the source as
+     * raw memory? A list is just head, tail and length (nodes never point back to
+     * the list), so it is relocatable whenever its allocator is.
+     */
+    template <typename T>
+    struct is_trivially_relocatable 
+        : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+    template <typename T>
+    struct is_trivially_relocatable<std::allocator<T>> : std::true_type {};
+
+#if ZLIST_HAS_PMR
+    template <typename T>
+    struct is_trivially_relocatable<std::pmr::polymorphic_allocator<T>> : std::true_type {};
+#endif
+
+#ifdef ZLIST_DEBUG_ITERATORS
+    // Tracked iterators point back at the list's registry.
+    template <typename T, typename Allocator>
+    struct is_trivially_relocatable<list<T, Allocator>> : std::false_type {};
+#else
+    template <typename T, typename Allocator>
+    struct is_trivially_relocatable<list<T, Allocator>>
+        : std::integral_constant<bool, std::is_empty<Allocator>::value ||
+                                       is_trivially_relocatable<Allocator>::value> {};
+#endif
+
+    // Moves [first, last) into uninitialized 'dest' and ends the source objects.
+    template <typename T>
+    T *relocate(T *first, T *last, T *dest) noexcept(is_trivially_relocatable<T>::value ||
+                                                     std::is_nothrow_move_constructible<T>::value)
+    {
+        return detail::relocate_impl(first, last, dest, is_trivially_relocatable<T>());
+    }
+
+    namespace detail
+    {
+        // Fixed block of node slots embedded in a small_list, recycled through a free list.
+        class inline_arena
+        {
+        public:
+            inline_arena(unsigned char *storage, size_t size, size_t align, size_t count) noexcept
+                : base(storage), slot_size(size), slot_align(align), slots(count), used(0), free_list(nullptr) {}
+
+            inline_arena(const inline_arena &) = delete;
+            inline_arena &operator=(const inline_arena &) = delete;
+
+            // Returns nullptr when full or when the request does not fit a slot.
+            void *take(size_t size, size_t align) noexcept
+            {
+                if (size > slot_size || align > slot_align)
+                {
+                    return nullptr;
+                }
+                if (free_list)
+                {
+                    void *p = free_list;
+                    free_list = *static_cast<void**>(p);
+                    return p;
+                }
+                if (used < slots)
+                {
+                    return base + slot_size * used++;
+                }
+                return nullptr;
+            }
+
+            // Returns false if 'p' is not one of the inline slots.
+            bool give_back(void *p) noexcept
+            {
+                unsigned char *c = static_cast<unsigned char*>(p);
+                if (c < base || c >= base + slot_size * slots)
+                {
+                    return false;
+                }
+                *static_cast<void**>(p) = free_list;
+                free_list = p;
+                return true;
+            }
+
+        private:
+            unsigned char *base;
+            size_t slot_size;
+            size_t slot_align;
+            size_t slots;
+            size_t used;
+            void *free_list;
+        };
+
+        template <typename Node, size_t N>
+        struct small_list_storage
+        {
+            static_assert(N > 0, "small_list needs at least one inline node");
+            static_assert(sizeof(Node) >= sizeof(void*), "node too small for the free list");
+
+            alignas(Node) unsigned char slots[N * sizeof(Node)];
+            inline_arena arena;
+
+            small_list_storage() noexcept : arena(slots, sizeof(Node), alignof(Node), N) {}
+        };
+    } // namespace detail
+
+    /* * Allocator for small_list: single nodes come from the owning list's inline
+     * arena while it has room, everything else goes to the heap. Two instances are
+     * equal only when they share an arena, so nodes never leave their arena.
+     */
+    template <typename T>
+    class inline_allocator
+    {
+    public:
+        using value_type = T;
+
+        explicit inline_allocator(detail::inline_arena *a) noexcept : arena(a) {}
+
+        template <typename U>
+        inline_allocator(const inline_allocator<U> &other) noexcept : arena(other.arena) {}
+
+        // Copies of a container start on the heap; the arena belongs to one object.
+        inline_allocator select_on_container_copy_construction() const noexcept
+        {
+            return inline_allocator(nullptr);
+        }
+
+        T *allocate(size_t n)
+        {
+            if (1 == n && arena)
+            {
+                void *p = arena->take(sizeof(T), alignof(T));
+                if (p) return static_cast<T*>(p);
+            }
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T *p, size_t n) noexcept
+        {
+            if (1 == n && arena && arena->give_back(p))
+            {
+                return;
+            }
+            ::operator delete(p);
+        }
+
+        template <typename U>
+        bool operator==(const inline_allocator<U> &other) const noexcept { return arena == other.arena; }
+
+        template <typename U>
+        bool operator!=(const inline_allocator<U> &other) const noexcept { return arena != other.arena; }
+
+        detail::inline_arena *arena;
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        struct is_object_bound<inline_allocator<T>> : std::true_type {};
+    }
+
+    /* * List with N nodes embedded in the object; only the overflow is heap
+     * allocated. It is a z_list::list, so iterators, node handles and splice behave
+     * the same. Inline nodes cannot change owner: inline_allocator is object
+     * bound, so moves, swaps and splices with any other list move the elements
+     * instead of relinking, even through a list reference, and extract() hands out
+     * a heap node that is free to outlive the list.
+     */
+    template <typename T, size_t N>
+    class small_list : private detail::small_list_storage<typename traits<T>::node_type, N>,
+                       public list<T, inline_allocator<T>>
+    {
+        using storage = detail::small_list_storage<typename traits<T>::node_type, N>;
+        using base = list<T, inline_allocator<T>>;
+
+    public:
+        small_list() : storage(), base(local_alloc()) {}
+
+        small_list(std::initializer_list<T> init) : storage(), base(init, local_alloc()) {}
+
+        small_list(const small_list &other) : storage(), base(other, local_alloc()) {}
+
+        small_list(small_list &&other) : storage(), base(std::move(other), local_alloc()) {}
+
+        small_list &operator=(const small_list &other)
+        {
+            base::operator=(other);
+            return *this;
+        }
+
+        small_list &operator=(small_list &&other)
+        {
+            base::operator=(std::move(other));
+            return *this;
+        }
+
+        small_list &operator=(std::initializer_list<T> init)
+        {
+            base::assign(init);
+            return *this;
+        }
+
+        // Three element-wise moves; may throw. Inline nodes cannot change owner.
+        void swap(small_list &other)
+        {
+            small_list temp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temp);
+        }
+
+        static constexpr size_t inline_capacity() noexcept
+        {
+            return N;
+        }
+
+    private:
+        inline_allocator<T> local_alloc() noexcept
+        {
+            return inline_allocator<T>(&this->arena);
+        }
+    };
+
+    template <typename T, size_t N>
+    void swap(small_list<T, N> &a, small_list<T, N> &b)
+    {
+        a.swap(b);
+    }
+
+    // Inline nodes live inside the object, so a memcpy would leave them behind.
+    template <typename T, size_t N>
+    struct is_trivially_relocatable<small_list<T, N>> : std::false_type {};
+
+#if ZLIST_HAS_PARALLEL
+    namespace detail
+    {
+        /* * Process-wide pool with one worker per extra hardware thread. The caller
+         * of run() executes a share of the work and helps drain the queue while it
+         * waits, so nested parallel calls cannot starve the pool.
+         */
+        class parallel_pool
+        {
+        public:
+            static parallel_pool &instance()
+            {
+                static parallel_pool pool;
+                return pool;
+            }
+
+            size_t concurrency() const noexcept
+            {
+                return workers.size() + 1;
+            }
+
+            // Calls fn(0) .. fn(count - 1) and returns when all of them finished.
+            template <typename Fn>
+            void run(size_t count, Fn &fn)
+            {
+                batch b;
+                b.pending = count;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    for (size_t i = 1; i < count; i++)
+                    {
+                        tasks.emplace_back([this, &b, &fn, i]() { execute(b, fn, i); });
+                    }
+                }
+                work_cv.notify_all();
+                execute(b, fn, 0);
+
+                std::unique_lock<std::mutex> lock(mutex);
+                while (b.pending > 0)
+                {
+                    if (!tasks.empty())
+                    {
+                        std::function<void()> task = std::move(tasks.front());
+                        tasks.pop_front();
+                        lock.unlock();
+                        task();
+                        lock.lock();
+                    }
+                    else
+                    {
+                        b.done.wait(lock);
+                    }
+                }
+                if (b.error)
+                {
+                    std::rethrow_exception(b.error);
+                }
+            }
+
+        private:
+            struct batch
+            {
+                size_t pending = 0;
+                std::exception_ptr error;
+                std::condition_variable done;
+            };
+
+            std::vector<std::thread> workers;
+            std::deque<std::function<void()>> tasks;
+            std::mutex mutex;
+            std::condition_variable work_cv;
+            bool stopping = false;
+
+            parallel_pool()
+            {
+                unsigned threads = ZLIST_PARALLEL_THREADS;
+                if (0 == threads) threads = std::thread::hardware_concurrency();
+                for (unsigned i = 1; i < threads; i++)
+                {
+                    workers.emplace_back([this]() { worker_loop(); });
+                }
+            }
+
+            ~parallel_pool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stopping = true;
+                }
+                work_cv.notify_all();
+                for (auto &w : workers)
+                {
+                    w.join();
+                }
+            }
+
+            template <typename Fn>
+            void execute(batch &b, Fn &fn, size_t i)
+            {
+                std::exception_ptr error;
+                try
+                {
+                    fn(i);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                if (error && !b.error) b.error = error;
+                if (0 == --b.pending) b.done.notify_all();
+            }
+
+            void worker_loop()
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                for (;;)
+                {
+                    work_cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                    if (tasks.empty())
+                    {
+                        return;
+                    }
+                    std::function<void()> task = std::move(tasks.front());
+                    tasks.pop_front();
+                    lock.unlock();
+                    task();
+                    lock.lock();
+                }
+            }
+        };
+
+        template <typename Policy>
+        struct is_serial_policy : std::integral_constant<bool,
+            std::is_same<typename std::decay<Policy>::type, std::execution::sequenced_policy>::value
+#if defined(__cpp_lib_execution) && __cpp_lib_execution >= 201902L
+            || std::is_same<typename std::decay<Policy>::type, std::execution::unsequenced_policy>::value
+#endif
+            > {};
+
+        template <typename Policy, typename R = void>
+        using enable_for_policy = 
+            typename std::enable_if<std::is_execution_policy<typename std::decay<Policy>::type>::value, R>::type;
+
+        /* * Splits 'l' into balanced segments using its known length. Returns the
+         * first node of each segment plus a trailing nullptr. One pointer walk.
+         */
+        template <typename CList>
+        auto split_segments(const CList &l) -> std::vector<decltype(l.head)>
+        {
+            size_t parts = parallel_pool::instance().concurrency();
+            size_t by_grain = l.length / ZLIST_PARALLEL_GRAIN;
+            if (by_grain < parts) parts = by_grain > 0 ? by_grain : 1;
+
+            std::vector<decltype(l.head)> bounds;
+            bounds.reserve(parts + 1);
+            auto curr = l.head;
+            for (size_t i = 0; i < parts; i++)
+            {
+                bounds.push_back(curr);
+                size_t len = l.length / parts + (i < l.length % parts ? 1 : 0);
+                while (len-- > 0) curr = curr->next;
+            }
+            bounds.push_back(nullptr);
+            return bounds;
+        }
+    } // namespace detail
+
+    /* * Parallel algorithms. With std::execution::par/par_unseq the list is split
+     * into size()-balanced segments that run on the shared pool. seq/unseq run
+     * serially on the calling thread.
+     */
+    template <typename Policy, typename T, typename Allocator, typename F>
+    detail::enable_for_policy<Policy> for_each(Policy &&, list<T, Allocator> &l, F f)
+    {
+        if (detail::is_serial_policy<Policy>::value)
+        {
+            for (T &item : l) f(item);
+            return;
+        }
+        auto bounds = detail::split_segments(l.inner);
+        auto work = [&](size_t i)
+        {
+            for (auto n = bounds[i]; n != bounds[i + 1]; n = n->next) f(n->value);
+        };
+        detail::parallel_pool::instance().run(bounds.size() - 1, work);
+    }
+
+    template <typename Policy, typename T, typename Allocator, typename Pred>
+    detail::enable_for_policy<Policy, size_t> count_if(Policy &&, const list<T, Allocator> &l, Pred pred)
+    {
+        if (detail::is_serial_policy<Policy>::value)
+        {
+            size_t count = 0;
+            for (const T &item : l) if (pred(item)) count++;
+            return count;
+        }
+        auto bounds = detail::split_segments(l.inner);
+        std::vector<size_t> partial(bounds.size() - 1, 0);
+        auto work = [&](size_t i)
+        {
+            size_t count = 0;
+            for (auto n = bounds[i]; n != bounds[i + 1]; n = n->next) if (pred(n->value)) count++;
+            partial[i] = count;
+        };
+        detail::parallel_pool::instance().run(partial.size(), work);
+        size_t total = 0;
+        for (size_t c : partial) total += c;
+        return total;
+    }
+
+    // 'reduce' must be associative. Segment results are combined left to right.
+    template <typename Policy, typename T, typename Allocator, typename U, typename Reduce, typename Transform>
+    detail::enable_for_policy<Policy, U> transform_reduce(Policy &&, const list<T, Allocator> &l, U init,
+                                                          Reduce reduce, Transform transform)
+    {
+        if (detail::is_serial_policy<Policy>::value || l.empty())
+        {
+            for (const T &item : l) init = reduce(std::move(init), transform(item));
+            return init;
+        }
+        auto bounds = detail::split_segments(l.inner);
+        std::vector<U> partial;
+        partial.reserve(bounds.size() - 1);
+        for (size_t i = 0; i + 1 < bounds.size(); i++) partial.push_back(init);
+        auto work = [&](size_t i)
+        {
+            auto n = bounds[i];
+            U acc = transform(n->value);
+            for (n = n->next; n != bounds[i + 1]; n = n->next) acc = reduce(std::move(acc), transform(n->value));
+            partial[i] = std::move(acc);
+        };
+        detail::parallel_pool::instance().run(partial.size(), work);
+        for (auto &p : partial) init = reduce(std::move(init), std::move(p));
+        return init;
+    }
+
+    // Stable. Segments are sorted in parallel, then merged pairwise in parallel rounds.
+    template <typename Policy, typename T, typename Allocator, typename Compare>
+    detail::enable_for_policy<Policy> sort(Policy &&, list<T, Allocator> &l, Compare comp)
+    {
+        if (detail::is_serial_policy<Policy>::value)
+        {
+            l.sort(comp);
+            return;
+        }
+        auto runs = detail::split_segments(l.inner);
+        runs.pop_back();
+        if (runs.size() <= 1)
+        {
+            l.sort(comp);
+            return;
+        }
+        // Cut the chain into independent segments.
+        for (size_t i = 1; i < runs.size(); i++)
+        {
+            runs[i]->prev->next = nullptr;
+        }
+        auto sort_run = [&](size_t i)
+        {
+            Compare c = comp;
+            runs[i] = detail::sort_chain(runs[i], c);
+        };
+        detail::parallel_pool::instance().run(runs.size(), sort_run);
+
+        while (runs.size() > 1)
+        {
+            size_t pairs = runs.size() / 2;
+            auto merge_pair = [&](size_t i)
+            {
+                Compare c = comp;
+                runs[2 * i] = detail::merge_chains(runs[2 * i], runs[2 * i + 1], c);
+            };
+            detail::parallel_pool::instance().run(pairs, merge_pair);
+            for (size_t i = 0; i < pairs; i++)
+            {
+                runs[i] = runs[2 * i];
+            }
+            if (runs.size() % 2) 
+            {
+                runs[pairs] = runs.back();
+                runs.resize(pairs + 1);
+            }
+            else
+            {
+                runs.resize(pairs);
+            }
+        }
+        detail::relink_chain(&l.inner, runs[0]);
+    }
+
+    template <typename Policy, typename T, typename Allocator>
+    detail::enable_for_policy<Policy> sort(Policy &&policy, list<T, Allocator> &l)
+    {
+        sort(std::forward<Policy>(policy), l, detail::value_less());
+    }
+#endif
+
+#if ZLIST_HAS_COROUTINES
+    /* * Lazy, single-pass generator in the style of std::generator. Yielded values
+     * are observed by reference, so streaming a list never copies elements.
+     */
+    template <typename T>
+    class generator
+#if ZLIST_HAS_RANGES
+        : public std::ranges::view_interface<generator<T>>
+#endif
+    {
+    public:
+        struct promise_type
+        {
+            const T *current = nullptr;
+            std::exception_ptr error;
+
+            generator get_return_object() noexcept
+            {
+                return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            std::suspend_always final_suspend() const noexcept { return {}; }
+
+            std::suspend_always yield_value(const T &val) noexcept
+            {
+                current = std::addressof(val);
+                return {};
+            }
+
+            void return_void() const noexcept {}
+            void unhandled_exception() noexcept { error = std::current_exception(); }
+
+            // Generators only yield.
+            template <typename U>
+            std::suspend_never await_transform(U &&) = delete;
+        };
+
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        class iterator
+        {
+        public:
+            using value_type = T;
+            using difference_type = ptrdiff_t;
+
+            iterator() noexcept = default;
+            explicit iterator(handle_type h) noexcept : coro(h) {}
+
+            const T &operator*() const { return *coro.promise().current; }
+            const T *operator->() const { return coro.promise().current; }
+
+            iterator &operator++()
+            {
+                advance(coro);
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            bool operator==(std::default_sentinel_t) const noexcept
+            {
+                return !coro || coro.done();
+            }
+
+        private:
+            handle_type coro = nullptr;
+        };
+
+        generator() noexcept = default;
+        generator(generator &&other) noexcept : coro(std::exchange(other.coro, nullptr)) {}
+
+        generator &operator=(generator &&other) noexcept
+        {
+            if (this != &other)
+            {
+                if (coro) coro.destroy();
+                coro = std::exchange(other.coro, nullptr);
+            }
+            return *this;
+        }
+
+        ~generator()
+        {
+            if (coro) coro.destroy();
+        }
+
+        iterator begin()
+        {
+            if (coro && !coro.done())
+            {
+                advance(coro);
+            }
+            return iterator(coro);
+        }
+
+        std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    private:
+        handle_type coro = nullptr;
+
+        explicit generator(handle_type h) noexcept : coro(h) {}
+
+        static void advance(handle_type h)
+        {
+            h.resume();
+            if (h.promise().error)
+            {
+                std::rethrow_exception(std::exchange(h.promise().error, nullptr));
+            }
+        }
+    };
+
+    // Streams the elements of 'l' one at a time. 'l' must outlive the generator.
+    template <typename T, typename Allocator>
+    generator<T> stream(const list<T, Allocator> &l)
+    {
+        for (const T &item : l)
+        {
+            co_yield item;
+        }
+    }
+
+    /* * Single-threaded awaitable queue backed by a z_list::list.
+     * 'co_await q.pop()' suspends while the queue is empty. push_back()/push_front()
+     * resume the oldest waiting coroutine inline, on the producer's stack, so
+     * producer and consumer never cross a thread or an executor queue. Waiters are
+     * linked through their awaiters (which live in the coroutine frames), so waiting
+     * does not allocate. Not thread-safe; run producers and consumers on one
+     * executor. The queue must outlive its waiters: destroying it while a coroutine
+     * is suspended in pop() would leave that coroutine pointing at freed memory, so
+     * the destructor calls std::terminate() if anybody is still waiting, in release
+     * builds too.
+     */
+    template <typename T, typename Allocator = std::allocator<T>>
+    class async_queue
+    {
+    public:
+        class pop_awaiter
+        {
+        public:
+            explicit pop_awaiter(async_queue &q) noexcept : queue(&q) {}
+
+            bool await_ready() const noexcept
+            {
+                return !queue->items.empty();
+            }
+
+            void await_suspend(std::coroutine_handle<> h) noexcept
+            {
+                waiter = h;
+                next = nullptr;
+                if (queue->last_waiter) queue->last_waiter->next = this;
+                else queue->first_waiter = this;
+                queue->last_waiter = this;
+            }
+
+            T await_resume()
+            {
+                T val = std::move(queue->items.front());
+                queue->items.pop_front();
+                return val;
+            }
+
+        private:
+            async_queue *queue;
+            std::coroutine_handle<> waiter;
+            pop_awaiter *next = nullptr;
+            friend class async_queue;
+        };
+
+        async_queue() = default;
+        explicit async_queue(const Allocator &alloc) : items(alloc) {}
+
+        ~async_queue()
+        {
+            if (has_waiters()) std::terminate();
+        }
+
+        async_queue(const async_queue &) = delete;
+        async_queue &operator=(const async_queue &) = delete;
+
+        pop_awaiter pop() noexcept { return pop_awaiter(*this); }
+
+        // Non-suspending pop. Returns false when the queue is empty.
+        bool try_pop(T &out)
+        {
+            if (items.empty()) return false;
+            out = std::move(items.front());
+            items.pop_front();
+            return true;
+        }
+
+        void push_back(const T &val) { items.push_back(val); wake(); }
+        void push_back(T &&val) { items.push_back(std::move(val)); wake(); }
+        void push_front(const T &val) { items.push_front(val); wake(); }
+        void push_front(T &&val) { items.push_front(std::move(val)); wake(); }
+
+        size_t size() const noexcept { return items.size(); }
+        bool empty() const noexcept { return items.empty(); }
+        bool has_waiters() const noexcept { return nullptr != first_waiter; }
+
+    private:
+        list<T, Allocator> items;
+        pop_awaiter *first_waiter = nullptr;
+        pop_awaiter *last_waiter = nullptr;
+
+        void wake()
+        {
+            pop_awaiter *w = first_waiter;
+            if (w)
+            {
+                first_waiter = w->next;
+                if (!first_waiter) last_waiter = nullptr;
+                w->waiter.resume();
+            }
+        }
+    };
+#endif
+
+#if ZLIST_HAS_PMR
+    namespace pmr
+    {
+        template <typename T>
+        using list = z_list::list<T, std::pmr::polymorphic_allocator<T>>;
+    } // namespace pmr
+#endif
+} // namespace z_list
+
+#if ZLIST_HAS_RANGES
+// Views do not own their nodes, so their iterators outlive the view.
+template <typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<z_list::list_view<T>> = true;
+#endif
 
 extern "C" {
 #endif // __cplusplus
 
-// C implementation logic.
+// C implementation logic.
+
+#ifndef ZLIST_MALLOC
+    #define ZLIST_MALLOC(sz)      Z_MALLOC(sz)
+#endif
+
+#ifndef ZLIST_FREE
+    #define ZLIST_FREE(p)         Z_FREE(p)
+#endif
+
+#ifndef ZLIST_REALLOC
+    #define ZLIST_REALLOC(p, sz)  Z_REALLOC(p, sz)
+#endif
+
+// Safe API generator (zerror.h integration).
+#if Z_HAS_ZERROR && !defined(__cplusplus)
+
+    static inline zerr zlist_err_impl(int code, const char* msg, 
+                                     const char* file, int line, const char* func) 
+    {
+        return zerr_create_impl(code, file, line, func, "%s", msg);
+    }
+
+    #define ZLIST_GEN_SAFE_IMPL(T, Name)                                                        \
+        DEFINE_RESULT(T, Res_##Name)                                                            \
+                                                                                                \
+        static inline zres zlist_push_back_safe_##Name(zlist_##Name *l, T val,                  \
+                                                      const char* f, int ln, const char* fn)    \
+        {                                                                                       \
+            if (Z_OK != zlist_push_back_##Name(l, val))                                         \
+            {                                                                                   \
+                return zres_err(zlist_err_impl(Z_ENOMEM, "List Push OOM", f, ln, fn));          \
+            }                                                                                   \
+            return zres_ok();                                                                   \
+        }                                                                                       \
+                                                                                                \
+        static inline zres zlist_push_front_safe_##Name(zlist_##Name *l, T val,                 \
+                                                       const char* f, int ln, const char* fn)   \
+        {                                                                                       \
+            if (Z_OK != zlist_push_front_##Name(l, val))                                        \
+            {                                                                                   \
+                return zres_err(zlist_err_impl(Z_ENOMEM, "List Push OOM", f, ln, fn));          \
+            }                                                                                   \
+            return zres_ok();                                                                   \
+        }                                                                                       \
+                                                                                                \
+        static inline Res_##Name zlist_front_safe_##Name(zlist_##Name *l,                       \
+                                                        const char* f, int ln, const char* fn)  \
+        {                                                                                       \
+            if (!l->head)                                                                       \
+            {                                                                                   \
+                return Res_##Name##_err(zlist_err_impl(Z_EEMPTY, "List is empty", f, ln, fn));  \
+            }                                                                                   \
+            return Res_##Name##_ok(l->head->value);                                             \
+        }                                                                                       \
+                                                                                                \
+        static inline Res_##Name zlist_back_safe_##Name(zlist_##Name *l,                        \
+                                                       const char* f, int ln, const char* fn)   \
+        {                                                                                       \
+            if (!l->tail)                                                                       \
+            {                                                                                   \
+                return Res_##Name##_err(zlist_err_impl(Z_EEMPTY, "List is empty", f, ln, fn));  \
+            }                                                                                   \
+            return Res_##Name##_ok(l->tail->value);                                             \
+        }                                                                                       \
+                                                                                                \
+        static inline zres zlist_pop_back_safe_##Name(zlist_##Name *l,                          \
+                                                     const char* f, int ln, const char* fn)     \
+        {                                                                                       \
+            if (!l->tail)                                                                       \
+            {                                                                                   \
+                return zres_err(zlist_err_impl(Z_EEMPTY, "List is empty", f, ln, fn));          \
+            }                                                                                   \
+            zlist_pop_back_##Name(l);                                                           \
+            return zres_ok();                                                                   \
+        }                                                                                       \
+                                                                                                \
+        static inline zres zlist_pop_front_safe_##Name(zlist_##Name *l,                         \
+                                                      const char* f, int ln, const char* fn)    \
+        {                                                                                       \
+            if (!l->head)                                                                       \
+            {                                                                                   \
+                return zres_err(zlist_err_impl(Z_EEMPTY, "List is empty", f, ln, fn));          \
+            }                                                                                   \
+            zlist_pop_front_##Name(l);                                                          \
+            return zres_ok();                                                                   \
+        }
+
+#else
+#   define ZLIST_GEN_SAFE_IMPL(T, Name)
+#endif
+
+/* * Binary checkpoints (opt-in, POSIX). A stream is one zlist_io_header followed
+ * by 'length' raw values, so it only suits types that are safe to copy as bytes.
+ * The byte order field makes streams from a machine of the other endianness fail
+ * the header check instead of loading garbage.
+ */
+#if defined(ZLIST_ENABLE_IO) && !defined(__cplusplus)
+
+    #define ZLIST_IO_VERSION      1
+    #define ZLIST_IO_BYTE_ORDER   0x01020304u
+    #define ZLIST_IO_FNV_BASIS    0xcbf29ce484222325ull
+    #define ZLIST_IO_FNV_PRIME    0x100000001b3ull
+
+    // iovecs per writev/readv call.
+    #ifndef ZLIST_IO_BATCH
+        #if defined(IOV_MAX) && IOV_MAX < 1024
+            #define ZLIST_IO_BATCH IOV_MAX
+        #else
+            #define ZLIST_IO_BATCH 1024
+        #endif
+    #endif
+
+    // Read size of zlist_load(); the buffer grows for longer lines.
+    #ifndef ZLIST_LOAD_BUFFER
+        #define ZLIST_LOAD_BUFFER (1u << 20)
+    #endif
+
+    typedef struct
+    {
+        char     magic[4];      // "ZLST".
+        uint32_t byte_order;    // ZLIST_IO_BYTE_ORDER as the writer stored it.
+        uint16_t version;
+        uint16_t header_size;
+        uint32_t elem_size;
+        uint64_t length;
+        uint64_t checksum;      // FNV-1a over the payload bytes.
+    } zlist_io_header;
+
+    static inline uint64_t zlist_io_fnv1a(uint64_t h, const void *data, size_t size)
+    {
+        const unsigned char *p = (const unsigned char *)data;
+        while (size--)
+        {
+            h = (h ^ *p++) * ZLIST_IO_FNV_PRIME;
+        }
+        return h;
+    }
+
+    static inline void zlist_io_header_init(zlist_io_header *h, size_t elem_size,
+                                            size_t length, uint64_t checksum)
+    {
+        memcpy(h->magic, "ZLST", 4);
+        h->byte_order = ZLIST_IO_BYTE_ORDER;
+        h->version = ZLIST_IO_VERSION;
+        h->header_size = (uint16_t)sizeof(zlist_io_header);
+        h->elem_size = (uint32_t)elem_size;
+        h->length = (uint64_t)length;
+        h->checksum = checksum;
+    }
+
+    static inline int zlist_io_header_check(const zlist_io_header *h, size_t elem_size)
+    {
+        if (0 != memcmp(h->magic, "ZLST", 4) || ZLIST_IO_BYTE_ORDER != h->byte_order ||
+            ZLIST_IO_VERSION != h->version || sizeof(zlist_io_header) != h->header_size ||
+            elem_size != h->elem_size)
+        {
+            return Z_EINVAL;
+        }
+        return Z_OK;
+    }
+
+    // Retries short transfers and EINTR. I/O errors return Z_ERR with errno set.
+    static inline int zlist_io_writev_all(int fd, struct iovec *iov, int cnt)
+    {
+        while (cnt > 0)
+        {
+            ssize_t n = writev(fd, iov, cnt);
+            if (n < 0)
+            {
+                if (EINTR == errno) continue;
+                return Z_ERR;
+            }
+            while (cnt > 0 && (size_t)n >= iov->iov_len)
+            {
+                n -= (ssize_t)iov->iov_len;
+                iov++;
+                cnt--;
+            }
+            if (cnt > 0)
+            {
+                iov->iov_base = (char *)iov->iov_base + n;
+                iov->iov_len -= (size_t)n;
+            }
+        }
+        return Z_OK;
+    }
+
+    // Like zlist_io_writev_all(); a stream that ends early is Z_EINVAL.
+    static inline int zlist_io_readv_all(int fd, struct iovec *iov, int cnt)
+    {
+        while (cnt > 0)
+        {
+            ssize_t n = readv(fd, iov, cnt);
+            if (n < 0)
+            {
+                if (EINTR == errno) continue;
+                return Z_ERR;
+            }
+            if (0 == n) return Z_EINVAL;
+            while (cnt > 0 && (size_t)n >= iov->iov_len)
+            {
+                n -= (ssize_t)iov->iov_len;
+                iov++;
+                cnt--;
+            }
+            if (cnt > 0)
+            {
+                iov->iov_base = (char *)iov->iov_base + n;
+                iov->iov_len -= (size_t)n;
+            }
+        }
+        return Z_OK;
+    }
+
+    // One writev(), or sendmsg() with 'flags' when 'msg' is set.
+    static inline ssize_t zlist_io_transmit(int fd, struct iovec *iov, int cnt, int flags,
+                                            int msg)
+    {
+        struct msghdr hdr;
+        if (!msg) return writev(fd, iov, cnt);
+        memset(&hdr, 0, sizeof(hdr));
+        hdr.msg_iov = iov;
+        hdr.msg_iovlen = (size_t)cnt;
+        return sendmsg(fd, &hdr, flags);
+    }
+
+    #define ZLIST_GEN_IO_IMPL(T, Name)                                                          \
+        /* Writes header + payload. The checksum pass comes first so the header can */          \
+        /* lead the stream even on pipes and sockets. */                                        \
+        static inline int zlist_write_##Name(const zlist_##Name *l, int fd)                     \
+        {                                                                                       \
+            zlist_io_header hdr;                                                                \
+            struct iovec iov[ZLIST_IO_BATCH];                                                   \
+            const zlist_node_##Name *curr;                                                      \
+            uint64_t sum = ZLIST_IO_FNV_BASIS;                                                  \
+            int cnt = 1;                                                                        \
+            int rc;                                                                             \
+            for (curr = l->head; curr; curr = curr->next)                                       \
+            {                                                                                   \
+                sum = zlist_io_fnv1a(sum, &curr->value, sizeof(T));                             \
+            }                                                                                   \
+            zlist_io_header_init(&hdr, sizeof(T), l->length, sum);                              \
+            iov[0].iov_base = &hdr;                                                             \
+            iov[0].iov_len = sizeof(hdr);                                                       \
+            for (curr = l->head; curr; curr = curr->next)                                       \
+            {                                                                                   \
+                iov[cnt].iov_base = (void *)&curr->value;                                       \
+                iov[cnt].iov_len = sizeof(T);                                                   \
+                if (ZLIST_IO_BATCH == ++cnt)                                                    \
+                {                                                                               \
+                    rc = zlist_io_writev_all(fd, iov, cnt);                                     \
+                    if (Z_OK != rc) return rc;                                                  \
+                    cnt = 0;                                                                    \
+                }                                                                               \
+            }                                                                                   \
+            return cnt ? zlist_io_writev_all(fd, iov, cnt) : Z_OK;                              \
+        }                                                                                       \
+                                                                                                \
+        /* Appends the stream to 'l'. Each batch of nodes is filled by one readv */             \
+        /* straight into the values; on error 'l' is left untouched. */                         \
+        static inline int zlist_read_##Name(zlist_##Name *l, int fd)                            \
+        {                                                                                       \
+            zlist_io_header hdr;                                                                \
+            struct iovec iov[ZLIST_IO_BATCH];                                                   \
+            zlist_##Name chain = zlist_init_##Name();                                           \
+            uint64_t sum = ZLIST_IO_FNV_BASIS;                                                  \
+            uint64_t left;                                                                      \
+            int rc;                                                                             \
+            iov[0].iov_base = &hdr;                                                             \
+            iov[0].iov_len = sizeof(hdr);                                                       \
+            rc = zlist_io_readv_all(fd, iov, 1);                                                \
+            if (Z_OK == rc) rc = zlist_io_header_check(&hdr, sizeof(T));                        \
+            left = (Z_OK == rc) ? hdr.length : 0;                                               \
+            while (left > 0 && Z_OK == rc)                                                      \
+            {                                                                                   \
+                zlist_node_##Name *last = chain.tail;                                           \
+                int cnt = 0;                                                                    \
+                while (cnt < ZLIST_IO_BATCH && (uint64_t)cnt < left)                            \
+                {                                                                               \
+                    zlist_node_##Name *n = (zlist_node_##Name*)                                 \
+                                           ZLIST_MALLOC(sizeof(zlist_node_##Name));             \
+                    if (!n)                                                                     \
+                    {                                                                           \
+                        rc = Z_ENOMEM;                                                          \
+                        break;                                                                  \
+                    }                                                                           \
+                    ZLIST_M_ALLOCATED(Name, n);                                                 \
+                    ZLIST_S_NODE_INIT(n);                                                       \
+                    ZLIST_J_NODE_INIT(n);                                                       \
+                    zlist_link_before_##Name(&chain, NULL, n);                                  \
+                    iov[cnt].iov_base = &n->value;                                              \
+                    iov[cnt].iov_len = sizeof(T);                                               \
+                    cnt++;                                                                      \
+                }                                                                               \
+                if (Z_OK == rc) rc = zlist_io_readv_all(fd, iov, cnt);                          \
+                last = last ? last->next : chain.head;                                          \
+                for (; last && Z_OK == rc; last = last->next)                                   \
+                {                                                                               \
+                    sum = zlist_io_fnv1a(sum, &last->value, sizeof(T));                         \
+                }                                                                               \
+                left -= (uint64_t)cnt;                                                          \
+            }                                                                                   \
+            if (Z_OK == rc && sum != hdr.checksum) rc = Z_EINVAL;                               \
+            if (Z_OK != rc)                                                                     \
+            {                                                                                   \
+                zlist_clear_##Name(&chain);                                                     \
+                return rc;                                                                      \
+            }                                                                                   \
+            zlist_splice_##Name(l, &chain);                                                     \
+            return Z_OK;                                                                        \
+        }                                                                                       \
+                                                                                                \
+        /* Queued output: each value maps to one buffer through 'to_iov'. Values are */         \
+        /* popped (after 'done', if given) once fully sent; '*offset' is how much of */         \
+        /* the head's buffer already went out. Stops when the list is empty or the */           \
+        /* descriptor would block; both are Z_OK. Other errors are Z_ERR (errno). */            \
+        static inline int zlist_io_send_##Name(zlist_##Name *l, int fd, int flags, int msg,     \
+                                               size_t *offset,                                  \
+                                               struct iovec (*to_iov)(const T *),               \
+                                               void (*done)(T *))                               \
+        {                                                                                       \
+            struct iovec iov[ZLIST_IO_BATCH];                                                   \
+            while (l->head)                                                                     \
+            {                                                                                   \
+                const zlist_node_##Name *curr = l->head;                                        \
+                size_t left;                                                                    \
+                ssize_t n;                                                                      \
+                int cnt = 0;                                                                    \
+                int i;                                                                          \
+                for (; curr && cnt < ZLIST_IO_BATCH; curr = curr->next)                         \
+                {                                                                               \
+                    iov[cnt++] = to_iov(&curr->value);                                          \
+                }                                                                               \
+                iov[0].iov_base = (char *)iov[0].iov_base + *offset;                            \
+                iov[0].iov_len -= *offset;                                                      \
+                n = zlist_io_transmit(fd, iov, cnt, flags, msg);                                \
+                if (n < 0)                                                                      \
+                {                                                                               \
+                    if (EINTR == errno) continue;                                               \
+                    return (EAGAIN == errno || EWOULDBLOCK == errno) ? Z_OK : Z_ERR;            \
+                }                                                                               \
+                left = (size_t)n;                                                               \
+                for (i = 0; i < cnt && left >= iov[i].iov_len; i++)                             \
+                {                                                                               \
+                    left -= iov[i].iov_len;                                                     \
+                    *offset = 0;                                                                \
+                    if (done) done(&l->head->value);                                            \
+                    zlist_pop_front_##Name(l);                                                  \
+                }                                                                               \
+                if (i < cnt) *offset += left;                                                   \
+                if (0 == n && 0 == i) return Z_ERR;                                             \
+            }                                                                                   \
+            return Z_OK;                                                                        \
+        }                                                                                       \
+                                                                                                \
+        static inline int zlist_writev_##Name(zlist_##Name *l, int fd, size_t *offset,          \
+                                              struct iovec (*to_iov)(const T *),                \
+                                              void (*done)(T *))                                \
+        {                                                                                       \
+            return zlist_io_send_##Name(l, fd, 0, 0, offset, to_iov, done);                     \
+        }                                                                                       \
+                                                                                                \
+        static inline int zlist_sendmsg_##Name(zlist_##Name *l, int fd, int flags,              \
+                                               size_t *offset,                                  \
+                                               struct iovec (*to_iov)(const T *),               \
+                                               void (*done)(T *))                               \
+        {                                                                                       \
+            return zlist_io_send_##Name(l, fd, flags, 1, offset, to_iov, done);                 \
+        }                                                                                       \
+                                                                                                \
+        /* Text loader: reads 'fd' in ZLIST_LOAD_BUFFER chunks and hands every line */          \
+        /* (without its newline / CRLF) to 'parse', which writes the value straight */          \
+        /* into a waiting node. parse returns 1 to keep it, 0 to skip the line and */           \
+        /* < 0 to fail with Z_EINVAL. New nodes are appended only if all goes well. */          \
+        static inline int zlist_load_##Name(zlist_##Name *l, int fd,                            \
+                                            int (*parse)(const char *, size_t, T *, void *),    \
+                                            void *ctx)                                          \
+        {                                                                                       \
+            zlist_##Name chain = zlist_init_##Name();                                           \
+            zlist_node_##Name *spare = NULL;                                                    \
+            size_t cap = ZLIST_LOAD_BUFFER;                                                     \
+            size_t have = 0;                                                                    \
+            int eof = 0;                                                                        \
+            int rc = Z_OK;                                                                      \
+            char *buf = (char *)ZLIST_MALLOC(cap);                                              \
+            if (!buf) return Z_ENOMEM;                                                          \
+            while (Z_OK == rc && (!eof || have))                                                \
+            {                                                                                   \
+                char *line = buf;                                                               \
+                char *nl;                                                                       \
+                if (!eof)                                                                       \
+                {                                                                               \
+                    ssize_t n;                                                                  \
+                    if (have == cap)                                                            \
+                    {                                                                           \
+                        char *grown = (char *)ZLIST_REALLOC(buf, cap * 2);                      \
+                        if (!grown)                                                             \
+                        {                                                                       \
+                            rc = Z_ENOMEM;                                                      \
+                            break;                                                              \
+                        }                                                                       \
+                        buf = line = grown;                                                     \
+                        cap *= 2;                                                               \
+                    }                                                                           \
+                    n = read(fd, buf + have, cap - have);                                       \
+                    if (n < 0)                                                                  \
+                    {                                                                           \
+                        if (EINTR != errno) rc = Z_ERR;                                         \
+                        continue;                                                               \
+                    }                                                                           \
+                    eof = (0 == n);                                                             \
+                    have += (size_t)n;                                                          \
+                }                                                                               \
+                while (Z_OK == rc)                                                              \
+                {                                                                               \
+                    size_t len;                                                                 \
+                    int kept;                                                                   \
+                    nl = (char *)memchr(line, '\n', have - (size_t)(line - buf));               \
+                    if (!nl && !(eof && line < buf + have)) break;                              \
+                    if (!nl) nl = buf + have;                                                   \
+                    len = (size_t)(nl - line);                                                  \
+                    if (len && '\r' == line[len - 1]) len--;                                    \
+                    if (!spare)                                                                 \
+                    {                                                                           \
+                        spare = (zlist_node_##Name *)ZLIST_MALLOC(sizeof(zlist_node_##Name));   \
+                        if (!spare)                                                             \
+                        {                                                                       \
+                            rc = Z_ENOMEM;                                                      \
+                            break;                                                              \
+                        }                                                                       \
+                        ZLIST_M_ALLOCATED(Name, spare);                                         \
+                        ZLIST_S_NODE_INIT(spare);                                               \
+                        ZLIST_J_NODE_INIT(spare);                                               \
+                    }                                                                           \
+                    kept = parse(line, len, &spare->value, ctx);                                \
+                    if (kept < 0) rc = Z_EINVAL;                                                \
+                    else if (kept)                                                              \
+                    {                                                                           \
+                        zlist_link_before_##Name(&chain, NULL, spare);                          \
+                        spare = NULL;                                                           \
+                    }                                                                           \
+                    line = nl < buf + have ? nl + 1 : nl;                                       \
+                }                                                                               \
+                have -= (size_t)(line - buf);                                                   \
+                memmove(buf, line, have);                                                       \
+            }                                                                                   \
+            ZLIST_FREE(buf);                                                                    \
+            if (spare) zlist_free_node_##Name(spare);                                           \
+            if (Z_OK != rc)                                                                     \
+            {                                                                                   \
+                zlist_clear_##Name(&chain);                                                     \
+                return rc;                                                                      \
+            }                                                                                   \
+            zlist_splice_##Name(l, &chain);                                                     \
+            return Z_OK;                                                                        \
+        }
+
+
+#else
+#   define ZLIST_GEN_IO_IMPL(T, Name)
+#endif
+
+/* * Region lists (opt-in, POSIX). Nodes live in a shared mapping and link by
+ * offset from the start of the region (0 = null), so a region can be mapped at
+ * any address and walked immediately, with no load step. It starts with a
+ * zlist_region_header; nodes are bump-allocated after it and recycled through
+ * a free list. Like zlist_write(), only byte-copyable types make sense here.
+ */
+#if ZLIST_HAS_REGION
+
+    #define ZLIST_REGION_VERSION     2
+    #define ZLIST_REGION_BYTE_ORDER  0x01020304u
+
+    // Header 'kind': what created the region, so the file and shm openers refuse each other's.
+    #define ZLIST_REGION_FILE        1u
+    #define ZLIST_REGION_SHM         2u
+
+    // Default size of a new region. It doubles whenever it runs out of nodes.
+    #ifndef ZLIST_MMAP_INITIAL
+        #define ZLIST_MMAP_INITIAL   (1u << 20)
+    #endif
+
+    typedef struct
+    {
+        char     magic[4];      // "ZLMM".
+        uint32_t byte_order;    // ZLIST_REGION_BYTE_ORDER as the creator stored it.
+        uint16_t version;
+        uint16_t header_size;   // Offset of the first node.
+        uint32_t node_size;
+        uint32_t elem_size;
+        uint32_t kind;          // ZLIST_REGION_FILE or ZLIST_REGION_SHM.
+        uint64_t capacity;      // Region size in bytes.
+        uint64_t used;          // Bump allocator top.
+        uint64_t free_head;     // Recycled nodes, chained through 'next'.
+        uint64_t head;
+        uint64_t tail;
+        uint64_t length;
+    } zlist_region_header;
+
+    // Common prefix of every region node: offsets of the neighbours.
+    typedef struct
+    {
+        uint64_t prev;
+        uint64_t next;
+    } zlist_region_link;
+
+    typedef struct
+    {
+        int fd;
+        bool growable;
+        unsigned char *base;
+        size_t size;
+    } zlist_region;
+
+    #define ZLIST_REGION_HDR(r)      ((zlist_region_header *)(r)->base)
+    #define ZLIST_REGION_AT(r, off)  ((zlist_region_link *)((r)->base + (off)))
+
+    static inline int zlist_region_map(zlist_region *r, int fd, size_t size, bool growable)
+    {
+        void *p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (MAP_FAILED == p) return Z_ERR;
+        r->fd = fd;
+        r->growable = growable;
+        r->base = (unsigned char *)p;
+        r->size = size;
+        return Z_OK;
+    }
+
+    static inline void zlist_region_unmap(zlist_region *r)
+    {
+        if (r->base) munmap(r->base, r->size);
+        if (r->fd >= 0) close(r->fd);
+        r->base = NULL;
+        r->size = 0;
+        r->fd = -1;
+    }
+
+    static inline void zlist_region_format(zlist_region *r, uint32_t kind, size_t elem_size,
+                                           size_t node_size, size_t header_size)
+    {
+        zlist_region_header *h = ZLIST_REGION_HDR(r);
+        memset(h, 0, header_size);
+        memcpy(h->magic, "ZLMM", 4);
+        h->byte_order = ZLIST_REGION_BYTE_ORDER;
+        h->version = ZLIST_REGION_VERSION;
+        h->kind = kind;
+        h->header_size = (uint16_t)header_size;
+        h->node_size = (uint32_t)node_size;
+        h->elem_size = (uint32_t)elem_size;
+        h->capacity = r->size;
+        h->used = header_size;
+    }
+
+    // True when off is the start of a node slot below the bump allocator top.
+    static inline int zlist_region_valid_offset(const zlist_region_header *h, uint64_t off)
+    {
+        return off >= h->header_size && off < h->used &&
+               0 == (off - h->header_size) % h->node_size;
+    }
+
+    static inline int zlist_region_check(const zlist_region *r, uint32_t kind, size_t elem_size,
+                                         size_t node_size)
+    {
+        const zlist_region_header *h = (const zlist_region_header *)r->base;
+        if (r->size < sizeof(zlist_region_header) || 0 != memcmp(h->magic, "ZLMM", 4) ||
+            ZLIST_REGION_BYTE_ORDER != h->byte_order || ZLIST_REGION_VERSION != h->version ||
+            kind != h->kind ||
+            node_size != h->node_size || elem_size != h->elem_size ||
+            h->capacity > r->size || h->used > h->capacity ||
+            h->header_size < sizeof(zlist_region_header) || h->header_size > h->used ||
+            0 != (h->used - h->header_size) % node_size)
+        {
+            return Z_EINVAL;
+        }
+        // The roots must name node slots, so a damaged header fails here rather than on a walk.
+        if ((h->head && !zlist_region_valid_offset(h, h->head)) ||
+            (h->tail && !zlist_region_valid_offset(h, h->tail)) ||
+            (h->free_head && !zlist_region_valid_offset(h, h->free_head)))
+        {
+            return Z_EINVAL;
+        }
+        return Z_OK;
+    }
+
+    // Doubles the file and maps it again. Node pointers (not offsets) go stale. On
+    // failure the file is cut back, so it still matches the header's capacity.
+    static inline int zlist_region_grow(zlist_region *r)
+    {
+        size_t new_size = r->size * 2;
+        void *p;
+        if (!r->growable || 0 != ftruncate(r->fd, (off_t)new_size)) return Z_ENOMEM;
+        p = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, r->fd, 0);
+        if (MAP_FAILED == p)
+        {
+            // zlist_region_check tolerates a file larger than capacity if this fails too.
+            int rc = ftruncate(r->fd, (off_t)r->size);
+            (void)rc;
+            return Z_ENOMEM;
+        }
+        munmap(r->base, r->size);
+        r->base = (unsigned char *)p;
+        r->size = new_size;
+        ZLIST_REGION_HDR(r)->capacity = new_size;
+        return Z_OK;
+    }
+
+    // Returns the offset of an unlinked node, or 0 when the region is full.
+    static inline uint64_t zlist_region_alloc(zlist_region *r)
+    {
+        zlist_region_header *h = ZLIST_REGION_HDR(r);
+        uint64_t off = h->free_head;
+        if (off)
+        {
+            h->free_head = ZLIST_REGION_AT(r, off)->next;
+            return off;
+        }
+        while (h->used + h->node_size > h->capacity)
+        {
+            if (Z_OK != zlist_region_grow(r)) return 0;
+            h = ZLIST_REGION_HDR(r);
+        }
+        off = h->used;
+        h->used += h->node_size;
+        return off;
+    }
+
+    static inline void zlist_region_release(zlist_region *r, uint64_t off)
+    {
+        zlist_region_header *h = ZLIST_REGION_HDR(r);
+        ZLIST_REGION_AT(r, off)->next = h->free_head;
+        h->free_head = off;
+    }
+
+    // Offset version of zlist_link_before (pos 0 = tail).
+    static inline void zlist_region_link_before(zlist_region *r, uint64_t pos, uint64_t off)
+    {
+        zlist_region_header *h = ZLIST_REGION_HDR(r);
+        zlist_region_link *n = ZLIST_REGION_AT(r, off);
+        if (!pos)
+        {
+            n->prev = h->tail;
+            n->next = 0;
+            if (h->tail) ZLIST_REGION_AT(r, h->tail)->next = off;
+            else h->head = off;
+            h->tail = off;
+        }
+        else
+        {
+            zlist_region_link *p = ZLIST_REGION_AT(r, pos);
+            n->prev = p->prev;
+            n->next = pos;
+            if (p->prev) ZLIST_REGION_AT(r, p->prev)->next = off;
+            else h->head = off;
+            p->prev = off;
+        }
+        h->length++;
+    }
+
+    static inline void zlist_region_unlink(zlist_region *r, uint64_t off)
+    {
+        zlist_region_header *h = ZLIST_REGION_HDR(r);
+        zlist_region_link *n = ZLIST_REGION_AT(r, off);
+        if (n->prev) ZLIST_REGION_AT(r, n->prev)->next = n->next;
+        else h->head = n->next;
+        if (n->next) ZLIST_REGION_AT(r, n->next)->prev = n->prev;
+        else h->tail = n->prev;
+        n->prev = n->next = 0;
+        h->length--;
+    }
+
+    // Node layout shared by every region list: zlist_region_link, then the value.
+    #define ZLIST_GEN_REGION_NODE(T, Name)                                                      \
+        typedef struct zlist_mnode_##Name                                                       \
+        {                                                                                       \
+            uint64_t prev;                                                                      \
+            uint64_t next;                                                                      \
+            T value;                                                                            \
+        } zlist_mnode_##Name;
+
+#else
+#   define ZLIST_GEN_REGION_NODE(T, Name)
+#endif
+
+// File-backed region lists.
+#if defined(ZLIST_ENABLE_MMAP) && !defined(__cplusplus)
+
+    static inline int zlist_region_create_file(zlist_region *r, const char *path, size_t capacity,
+                                               size_t elem_size, size_t node_size)
+    {
+        size_t header_size = (sizeof(zlist_region_header) + 63) & ~(size_t)63;
+        int fd;
+        if (capacity < header_size + node_size) capacity = ZLIST_MMAP_INITIAL;
+        fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return Z_ERR;
+        if (0 != ftruncate(fd, (off_t)capacity) || Z_OK != zlist_region_map(r, fd, capacity, true))
+        {
+            close(fd);
+            return Z_ERR;
+        }
+        zlist_region_format(r, ZLIST_REGION_FILE, elem_size, node_size, header_size);
+        return Z_OK;
+    }
+
+    static inline int zlist_region_open_file(zlist_region *r, const char *path,
+                                             size_t elem_size, size_t node_size)
+    {
+        struct stat st;
+        int rc;
+        int fd = open(path, O_RDWR);
+        if (fd < 0) return Z_ERR;
+        if (0 != fstat(fd, &st) || st.st_size <= 0 ||
+            Z_OK != zlist_region_map(r, fd, (size_t)st.st_size, true))
+        {
+            close(fd);
+            return Z_ERR;
+        }
+        rc = zlist_region_check(r, ZLIST_REGION_FILE, elem_size, node_size);
+        if (Z_OK != rc) zlist_region_unmap(r);
+        return rc;
+    }
+
+    #define ZLIST_GEN_MMAP_IMPL(T, Name)                                                        \
+        typedef struct                                                                          \
+        {                                                                                       \
+            zlist_region region;                                                                \
+        } zlist_mmap_##Name;                                                                    \
+                                                                                                \
+        static inline int zlist_mmap_create_##Name(zlist_mmap_##Name *m, const char *path,      \
+                                                   size_t capacity)                             \
+        {                                                                                       \
+            return zlist_region_create_file(&m->region, path, capacity,                         \
+                                            sizeof(T), sizeof(zlist_mnode_##Name));             \
+        }                                                                                       \
+                                                                                                \
+        static inline int zlist_mmap_open_##Name(zlist_mmap_##Name *m, const char *path)        \
+        {                                                                                       \
+            return zlist_region_open_file(&m->region, path,                                     \
+                                          sizeof(T), sizeof(zlist_mnode_##Name));               \
+        }                                                                                       \
+                                                                                                \
+        static inline void zlist_mmap_close_##Name(zlist_mmap_##Name *m)                        \
+        {                                                                                       \
+            zlist_region_unmap(&m->region);                                                     \
+        }                                                                                       \
+                                                                                                \
+        static inline int zlist_mmap_sync_##Name(zlist_mmap_##Name *m)                          \
+        {                                                                                       \
+            return 0 == msync(m->region.base, m->region.size, MS_SYNC) ? Z_OK : Z_ERR;          \
+        }                                                                                       \
+                                                                                                \
+        static inline size_t zlist_mmap_length_##Name(const zlist_mmap_##Name *m)               \
+        {                                                                                       \
+            return (size_t)((const zlist_region_header *)m->region.base)->length;               \
+        }                                                                                       \
+                                                                                                \
+        static inline zlist_mnode_##Name *zlist_mmap_node_##Name(zlist_mmap_##Name *m,          \
+                                                                uint64_t off)                   \
+        {                                                                                       \
+            return off ? (zlist_mnode_##Name *)(m->region.base + off) : NULL;                   \
+        }                                                                                       \
+                                                                                                \
+        static inline uint64_t zlist_mmap_offset_##Name(zlist_mmap_##Name *m,                   \
+                                                        const zlist_mnode_##Name *n)            \
+        {                                                                                       \
+            return n ? (uint64_t)((const unsigned char *)n - m->region.base) : 0;               \
+        }                                                                                       \
+                                                                                                \
+        static inline zlist_mnode_##Name *zlist_mmap_head_##Name(zlist_mmap_##Name *m)          \
+        {                                                                                       \
+            return zlist_mmap_node_##Name(m, ZLIST_REGION_HDR(&m->region)->head);               \
+        }                                                                                       \
+                                                                                                \
+        static inline zlist_mnode_##Name *zlist_mmap_tail_##Name(zlist_mmap_##Name *m)          \
+        {                                                                                       \
+            return zlist_mmap_node_##Name(m, ZLIST_REGION_HDR(&m->region)->tail);               \
+        }                                                                                       \
+                                                                                                \
+        static inline zlist_mnode_##Name *zlist_mmap_next_##Name(zlist_mmap_##Name *m,          \
+                                                                const zlist_mnode_##Name *n)    \
+        {                                                                                       \
+            return zlist_mmap_node_##Name(m, n->next);                                          \
+        }                                                                                       \
+                                                                                                \
+        static inline zlist_mnode_##Name *zlist_mmap_prev_##Name(zlist_mmap_##Name *m,          \
+                                                                const zlist_mnode_##Name *n)    \
+        {                                                                                       \
+            return zlist_mmap_node_##Name(m, n->prev);                                          \
+        }                                                                                       \
+                                                                                                \
+        static inline int zlist_mmap_push_back_##Name(zlist_mmap_##Name *m, T val)              \
+        {                                                                                       \
+            uint64_t off = zlist_region_alloc(&m->region);                                      \
+            if (!off) return Z_ENOMEM;                                                          \
+            zlist_mmap_node_##Name(m, off)->value = val;                                        \
+            zlist_region_link_before(&m->region, 0, off);                                       \
+            return Z_OK;                                                                        \
+        }                                                                                       \
+                                                                                                \
+        static inline int zlist_mmap_push_front_##Name(zlist_mmap_##Name *m, T val)             \
+        {                                                                                       \
+            uint64_t off = zlist_region_alloc(&m->region);                                      \
+            if (!off) return Z_ENOMEM;                                                          \
+            zlist_mmap_node_##Name(m, off)->value = val;                                        \
+            zlist_region_link_before(&m->region, ZLIST_REGION_HDR(&m->region)->head, off);      \
+            return Z_OK;                                                                        \
+        }                                                                                       \
+                                                                                                \
+        /* Copies the value to 'out' (if not NULL) and frees the node. */                       \
+        static inline int zlist_mmap_pop_back_##Name(zlist_mmap_##Name *m, T *out)              \
+        {                                                                                       \
+            uint64_t off = ZLIST_REGION_HDR(&m->region)->tail;                                  \
+            if (!off) return Z_EEMPTY;                                                          \
+            if (out) *out = zlist_mmap_node_##Name(m, off)->value;                              \
+            zlist_region_unlink(&m->region, off);                                               \
+            zlist_region_release(&m->region, off);                                              \
+            return Z_OK;                                                                        \
+        }                                                                                       \
+                                                                                                \
+        static inline int zlist_mmap_pop_front_##Name(zlist_mmap_##Name *m, T *out)             \
+        {                                                                                       \
+            uint64_t off = ZLIST_REGION_HDR(&m->region)->head;                                  \
+            if (!off) return Z_EEMPTY;                                                          \
+            if (out) *out = zlist_mmap_node_##Name(m, off)->value;                              \
+            zlist_region_unlink(&m->region, off);                                               \
+            zlist_region_release(&m->region, off);                                              \
+            return Z_OK;                                                                        \
+        }                                                                                       \
+                                                                                                \
+        static inline void zlist_mmap_remove_node_##Name(zlist_mmap_##Name *m,                  \
+                                                         zlist_mnode_##Name *n)                 \
+        {                                                                                       \
+            uint64_t off = zlist_mmap_offset_##Name(m, n);                                      \
+            if (!off) return;                                                                   \
+            zlist_region_unlink(&m->region, off);                                               \
+            zlist_region_release(&m->region, off);                                              \
+        }                                                                                       \
+                                                                                                \
+        /* O(1): resets the allocator instead of walking the nodes. */                          \
+        static inline void zlist_mmap_clear_##Name(zlist_mmap_##Name *m)                        \
+        {                                                                                       \
+            zlist_region_header *h = ZLIST_REGION_HDR(&m->region);                              \
+            h->head = h->tail = h->free_head = 0;                                               \
+            h->length = 0;                                                                      \
+            h->used = h->header_size;                                                           \
+        }
+
+
+#else
+#   define ZLIST_GEN_MMAP_IMPL(T, Name)
+#endif
+
+/* * Shared-memory lists (opt-in, POSIX). The same region layout in a shm_open
+ * object, guarded by a process-shared robust mutex stored after the region
+ * header. If a process dies holding the lock, the next locker repairs the list
+ * from its 'next' chain (the links are updated in an order that keeps that
+ * chain whole) and rebuilds the free list. Shared regions have a fixed size:
+ * growing would mean remapping in every attached process.
+ */
+#if defined(ZLIST_ENABLE_SHM) && !defined(__cplusplus)
+
+    #ifndef ZLIST_SHM_CAPACITY
+        #define ZLIST_SHM_CAPACITY   (1u << 20)
+    #endif
+
+    typedef struct
+    {
+        zlist_region_header base;
+        uint64_t recoveries;        // Times the lock was taken over from a dead owner.
+        pthread_mutex_t lock;
+        pthread_cond_t nonempty;    // Signalled on every push.
+    } zlist_shm_header;
+
+    #define ZLIST_SHM_HDR(r)  ((zlist_shm_header *)(r)->base)
+
+    // Rebuilds prev/tail/length from the 'next' chain and the free list from the rest.
+    static inline void zlist_shm_repair(zlist_region *r)
+    {
+        zlist_region_header *h = ZLIST_REGION_HDR(r);
+        uint64_t slots, off, prev = 0, count = 0;
+        unsigned char *seen;
+        if (h->used < h->header_size || h->used > h->capacity) h->used = h->header_size;
+        slots = (h->used - h->header_size) / h->node_size;
+        seen = (unsigned char *)ZLIST_MALLOC((size_t)(slots / 8 + 1));
+        if (seen) memset(seen, 0, (size_t)(slots / 8 + 1));
+        for (off = h->head; off && count < slots && zlist_region_valid_offset(h, off); )
+        {
+            uint64_t slot = (off - h->header_size) / h->node_size;
+            if (seen)
+            {
+                if (seen[slot / 8] & (1u << (slot % 8))) break;
+                seen[slot / 8] |= (unsigned char)(1u << (slot % 8));
+            }
+            ZLIST_REGION_AT(r, off)->prev = prev;
+            prev = off;
+            count++;
+            off = ZLIST_REGION_AT(r, off)->next;
+        }
+        if (prev) ZLIST_REGION_AT(r, prev)->next = 0;
+        else h->head = 0;
+        h->tail = prev;
+        h->length = count;
+        if (seen)
+        {
+            uint64_t slot;
+            h->free_head = 0;
+            for (slot = slots; slot-- > 0; )
+            {
+                if (!(seen[slot / 8] & (1u << (slot % 8))))
+                {
+                    zlist_region_release(r, h->header_size + slot * h->node_size);
+                }
+            }
+            ZLIST_FREE(seen);
+        }
+    }
+
+    // Maps pthread results, repairing the list when the previous owner died.
+    static inline int zlist_shm_locked(zlist_region *r, int rc)
+    {
+        if (EOWNERDEAD == rc)
+        {
+            zlist_shm_repair(r);
+            ZLIST_SHM_HDR(r)->recoveries++;
+            pthread_mutex_consistent(&ZLIST_SHM_HDR(r)->lock);
+            return Z_OK;
+        }
+        return 0 == rc ? Z_OK : Z_ERR;
+    }
+
+    static inline int zlist_shm_lock_region(zlist_region *r)
+    {
+        return zlist_shm_locked(r, pthread_mutex_lock(&ZLIST_SHM_HDR(r)->lock));
+    }
+
+    static inline void zlist_shm_unlock_region(zlist_region *r)
+    {
+        pthread_mutex_unlock(&ZLIST_SHM_HDR(r)->lock);
+    }
+
+    // Waits for a push with the lock held. timeout_ms < 0 waits forever.
+    static inline int zlist_shm_wait_region(zlist_region *r, int timeout_ms)
+    {
+        zlist_shm_header *h = ZLIST_SHM_HDR(r);
+        struct timespec deadline;
+        int rc = 0;
+        if (timeout_ms >= 0)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &deadline);
+            deadline.tv_sec += timeout_ms / 1000;
+            deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+            if (deadline.tv_nsec >= 1000000000L)
+            {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+        }
+        while (0 == h->base.length && 0 == rc)
+        {
+            rc = timeout_ms < 0 ? pthread_cond_wait(&h->nonempty, &h->lock)
+                                : pthread_cond_timedwait(&h->nonempty, &h->lock, &deadline);
+            if (EOWNERDEAD == rc) rc = zlist_shm_locked(r, rc);
+        }
+        if (0 == h->base.length) return ETIMEDOUT == rc ? Z_EEMPTY : Z_ERR;
+        return Z_OK;
+    }
+
+    static inline int zlist_shm_create_region(zlist_region *r, const char *name, size_t capacity,
+                                              size_t elem_size, size_t node_size)
+    {
+        size_t header_size = (sizeof(zlist_shm_header) + 63) & ~(size_t)63;
+        zlist_shm_header *h;
+        pthread_mutexattr_t ma;
+        pthread_condattr_t ca;
+        int fd;
+        if (capacity < header_size + node_size) capacity = ZLIST_SHM_CAPACITY;
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) return EEXIST == errno ? Z_EEXIST : Z_ERR;
+        if (0 != ftruncate(fd, (off_t)capacity) || Z_OK != zlist_region_map(r, fd, capacity, false))
+        {
+            close(fd);
+            shm_unlink(name);
+            return Z_ERR;
+        }
+        zlist_region_format(r, ZLIST_REGION_SHM, elem_size, node_size, header_size);
+        h = ZLIST_SHM_HDR(r);
+        pthread_mutexattr_init(&ma);
+        pthread_mutexattr_setpshared(&ma, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&ma, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&h->lock, &ma);
+        pthread_mutexattr_destroy(&ma);
+        pthread_condattr_init(&ca);
+        pthread_condattr_setpshared(&ca, PTHREAD_PROCESS_SHARED);
+        pthread_condattr_setclock(&ca, CLOCK_MONOTONIC);
+        pthread_cond_init(&h->nonempty, &ca);
+        pthread_condattr_destroy(&ca);
+        return Z_OK;
+    }
+
+    static inline int zlist_shm_open_region(zlist_region *r, const char *name,
+                                            size_t elem_size, size_t node_size)
+    {
+        struct stat st;
+        int rc;
+        int fd = shm_open(name, O_RDWR, 0600);
+        if (fd < 0) return Z_ERR;
+        if (0 != fstat(fd, &st) || (size_t)st.st_size < sizeof(zlist_shm_header) ||
+            Z_OK != zlist_region_map(r, fd, (size_t)st.st_size, false))
+        {
+            close(fd);
+            return Z_ERR;
+        }
+        rc = zlist_region_check(r, ZLIST_REGION_SHM, elem_size, node_size);
+        if (Z_OK == rc && ZLIST_REGION_HDR(r)->header_size < sizeof(zlist_shm_header)) rc = Z_EINVAL;
+        if (Z_OK != rc) zlist_region_unmap(r);
+        return rc;
+    }
+
+    // Removes the name; attached processes keep their mapping.
+    static inline int zlist_shm_unlink(const char *name)
+    {
+        return 0 == shm_unlink(name) ? Z_OK : Z_ERR;
+    }
+
+    #define ZLIST_GEN_SHM_IMPL(T, Name)                                                         \
+        typedef struct                                                                          \
+        {                                                                                       \
+            zlist_region region;                                                                \
+        } zlist_shm_##Name;                                                                     \
+                                                                                                \
+        static inline int zlist_shm_create_##Name(zlist_shm_##Name *q, const char *name,        \
+                                                  size_t capacity)                              \
+        {                                                                                       \
+            return zlist_shm_create_region(&q->region, name, capacity,                          \
+                                           sizeof(T), sizeof(zlist_mnode_##Name));              \
+        }                                                                                       \
+                                                                                                \
+        static inline int zlist_shm_open_##Name(zlist_shm_##Name *q, const char *name)          \
+        {                                                                                       \
+            return zlist_shm_open_region(&q->region, name,                                      \
+                                         sizeof(T), sizeof(zlist_mnode_##Name));                \
+        }                                                                                       \
+                                                                                                \
+        static inline void zlist_shm_close_##Name(zlist_shm_##Name *q)                          \
+        {                                                                                       \
+            zlist_region_unmap(&q->region);                                                     \
+        }                                                                                       \
+                                                                                                \
+        /* Explicit locking, for batches or for walking the nodes in place. */                  \
+        static inline int zlist_shm_lock_##Name(zlist_shm_##Name *q)                            \
+        {                                                                                       \
+            return zlist_shm_lock_region(&q->region);                                           \
+        }                                                                                       \
+                                                                                                \
+        static inline void zlist_shm_unlock_##Name(zlist_shm_##Name *q)                         \
+        {                                                                                       \
+            zlist_shm_unlock_region(&q->region);                                                \
+        }                                                                                       \
+                                                                                                \
+        static inline size_t zlist_shm_length_##Name(zlist_shm_##Name *q)                       \
+        {                                                                                       \
+            size_t n = 0;                                                                       \
+            if (Z_OK == zlist_shm_lock_region(&q->region))                                      \
+            {                                                                                   \
+                n = (size_t)ZLIST_REGION_HDR(&q->region)->length;                               \
+                zlist_shm_unlock_region(&q->region);                                            \
+            }                                                                                   \
+            return n;                                                                           \
+        }                                                                                       \
+                                                                                                \
+        static inline int zlist_shm_push_##Name(zlist_shm_##Name *q, T val, bool front)         \
+        {                                                                                       \
+            zlist_region_header *h = ZLIST_REGION_HDR(&q->region);                              \
+            uint64_t off;                                                                       \
+            int rc = zlist_shm_lock_region(&q->region);                                         \
+            if (Z_OK != rc) return rc;                                                          \
+            off = zlist_region_alloc(&q->region);                                               \
+            if (off)                                                                            \
+            {                                                                                   \
+                ((zlist_mnode_##Name *)(q->region.base + off))->value = val;                    \
+                zlist_region_link_before(&q->region, front ? h->head : 0, off);                 \
+                pthread_cond_signal(&ZLIST_SHM_HDR(&q->region)->nonempty);                      \
+            }                                                                                   \
+            zlist_shm_unlock_region(&q->region);                                                \
+            return off ? Z_OK : Z_ENOMEM;                                                       \
+        }                                                                                       \
+                                                                                                \
+        static inline int zlist_shm_push_back_##Name(zlist_shm_##Name *q, T val)                \
+        {                                                                                       \
+            return zlist_shm_push_##Name(q, val, false);                                        \
+        }                                                                                       \
+                                                                                                \
+        static inline int zlist_shm_push_front_##Name(zlist_shm_##Name *q, T val)               \
+        {                                                                                       \
+            return zlist_shm_push_##Name(q, val, true);                                         \
+        }                                                                                       \
+                                                                                                \
+        /* Pops the head into 'out' (if not NULL). With timeout_ms != 0 it first */             \
+        /* waits up to that long for a push (< 0: forever). Z_EEMPTY on timeout. */             \
+        static inline int zlist_shm_pop_front_##Name(zlist_shm_##Name *q, T *out,               \
+                                                     int timeout_ms)                            \
+        {                                                                                       \
+            zlist_region_header *h = ZLIST_REGION_HDR(&q->region);                              \
+            uint64_t off;                                                                       \
+            int rc = zlist_shm_lock_region(&q->region);                                         \
+            if (Z_OK != rc) return rc;                                                          \
+            if (0 != timeout_ms) rc = zlist_shm_wait_region(&q->region, timeout_ms);            \
+            off = h->head;                                                                      \
+            if (Z_OK == rc && off)                                                              \
+            {                                                                                   \
+                if (out) *out = ((zlist_mnode_##Name *)(q->region.base + off))->value;          \
+                zlist_region_unlink(&q->region, off);                                           \
+                zlist_region_release(&q->region, off);                                          \
+            }                                                                                   \
+            else if (Z_OK == rc)                                                                \
+            {                                                                                   \
+                rc = Z_EEMPTY;                                                                  \
+            }                                                                                   \
+            zlist_shm_unlock_region(&q->region);                                                \
+            return rc;                                                                          \
+        }                                                                                       \
+                                                                                                \
+        static inline int zlist_shm_pop_back_##Name(zlist_shm_##Name *q, T *out)                \
+        {                                                                                       \
+            zlist_region_header *h = ZLIST_REGION_HDR(&q->region);                              \
+            uint64_t off;                                                                       \
+            int rc = zlist_shm_lock_region(&q->region);                                         \
+            if (Z_OK != rc) return rc;                                                          \
+            off = h->tail;                                                                      \
+            if (off)                                                                            \
+            {                                                                                   \
+                if (out) *out = ((zlist_mnode_##Name *)(q->region.base + off))->value;          \
+                zlist_region_unlink(&q->region, off);                                           \
+                zlist_region_release(&q->region, off);                                          \
+            }                                                                                   \
+            zlist_shm_unlock_region(&q->region);                                                \
+            return off ? Z_OK : Z_EEMPTY;                                                       \
+        }
+
+
+#else
+#   define ZLIST_GEN_SHM_IMPL(T, Name)
+#endif
+
+/* * Write-ahead journal (opt-in, C, POSIX). A list with an attached journal
+ * appends a record for every mutation to a buffered log: nodes carry a journal
+ * id, so a record names the nodes it touches instead of an O(N) index. Records
+ * are [op][varint a][varint b][value if LINK][FNV-1a 32], so a torn tail from a
+ * crash is detected and cut off by replay. Direct writes to node->value are
+ * not journaled.
+ */
+#if defined(ZLIST_ENABLE_JOURNAL) && !defined(__cplusplus)
+
+    #define ZLIST_JOURNAL_VERSION     1
+    #define ZLIST_JOURNAL_BYTE_ORDER  0x01020304u
+
+    // Bytes buffered before a write(). Records are only durable after a commit.
+    #ifndef ZLIST_JOURNAL_BUFFER
+        #define ZLIST_JOURNAL_BUFFER  (64u << 10)
+    #endif
+
+    enum
+    {
+        ZLIST_JOP_LINK = 1,     // New node 'b' before node 'a' (0 = at the tail).
+        ZLIST_JOP_UNLINK,       // Node 'a' left the list.
+        ZLIST_JOP_CLEAR,
+        ZLIST_JOP_REVERSE
+    };
+
+    typedef struct
+    {
+        char     magic[4];      // "ZLJR".
+        uint32_t byte_order;
+        uint16_t version;
+        uint16_t reserved;
+        uint32_t elem_size;
+    } zlist_journal_header;
+
+    typedef struct zlist_journal
+    {
+        int fd;
+        int error;              // First failure, reported by commit and close.
+        char *path;
+        unsigned char *buf;
+        size_t len;
+        size_t cap;
+        size_t pending;         // Records since the last fdatasync.
+        size_t sync_every;      // Group commit size; 0 = only on zlist_journal_commit().
+        uint64_t size;          // Bytes already in the file.
+        uint64_t next_id;
+    } zlist_journal;
+
+    static inline uint32_t zlist_journal_fnv32(const unsigned char *p, size_t size)
+    {
+        uint32_t h = 0x811c9dc5u;
+        while (size--)
+        {
+            h = (h ^ *p++) * 0x01000193u;
+        }
+        return h;
+    }
+
+    static inline unsigned char *zlist_journal_put_varint(unsigned char *p, uint64_t v)
+    {
+        while (v >= 0x80)
+        {
+            *p++ = (unsigned char)(v | 0x80);
+            v >>= 7;
+        }
+        *p++ = (unsigned char)v;
+        return p;
+    }
+
+    static inline const unsigned char *zlist_journal_get_varint(const unsigned char *p,
+                                                                const unsigned char *end,
+                                                                uint64_t *v)
+    {
+        unsigned shift = 0;
+        *v = 0;
+        while (p < end && shift < 64)
+        {
+            unsigned char byte = *p++;
+            *v |= (uint64_t)(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return p;
+            shift += 7;
+        }
+        return NULL;
+    }
+
+    static inline int zlist_journal_write_all(int fd, const unsigned char *p, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t n = write(fd, p, size);
+            if (n < 0)
+            {
+                if (EINTR == errno) continue;
+                return Z_ERR;
+            }
+            p += n;
+            size -= (size_t)n;
+        }
+        return Z_OK;
+    }
+
+    static inline int zlist_journal_flush(zlist_journal *j)
+    {
+        if (j->len > 0 && Z_OK == j->error)
+        {
+            if (Z_OK != zlist_journal_write_all(j->fd, j->buf, j->len)) j->error = Z_ERR;
+            else j->size += j->len;
+        }
+        j->len = 0;
+        return j->error;
+    }
+
+    // Group commit: one write and one fdatasync for everything buffered.
+    static inline int zlist_journal_commit(zlist_journal *j)
+    {
+        if (Z_OK == zlist_journal_flush(j) && 0 != fdatasync(j->fd)) j->error = Z_ERR;
+        j->pending = 0;
+        return j->error;
+    }
+
+    static inline void zlist_journal_put(zlist_journal *j, int op, uint64_t a, uint64_t b,
+                                         const void *value, size_t size)
+    {
+        unsigned char *start;
+        unsigned char *p;
+        uint32_t crc;
+        if (j->cap - j->len < 1 + 20 + size + 4)
+        {
+            zlist_journal_flush(j);
+            if (j->cap < 1 + 20 + size + 4)
+            {
+                j->error = Z_ENOMEM;
+                return;
+            }
+        }
+        start = p = j->buf + j->len;
+        *p++ = (unsigned char)op;
+        p = zlist_journal_put_varint(p, a);
+        p = zlist_journal_put_varint(p, b);
+        if (value)
+        {
+            memcpy(p, value, size);
+            p += size;
+        }
+        crc = zlist_journal_fnv32(start, (size_t)(p - start));
+        memcpy(p, &crc, 4);
+        j->len += (size_t)(p + 4 - start);
+        if (j->sync_every && ++j->pending >= j->sync_every) zlist_journal_commit(j);
+    }
+
+    static inline void zlist_journal_linked(zlist_journal *j, uint64_t *id, uint64_t before,
+                                            const void *value, size_t size)
+    {
+        *id = j->next_id++;
+        zlist_journal_put(j, ZLIST_JOP_LINK, before, *id, value, size);
+    }
+
+    // Opens (or creates) a log for appending. sync_every > 0 commits every N records.
+    static inline int zlist_journal_open(zlist_journal *j, const char *path, size_t sync_every)
+    {
+        struct stat st;
+        size_t path_len = strlen(path) + 1;
+        memset(j, 0, sizeof(*j));
+        j->next_id = 1;
+        j->sync_every = sync_every;
+        j->fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (j->fd < 0) return Z_ERR;
+        j->buf = (unsigned char *)ZLIST_MALLOC(ZLIST_JOURNAL_BUFFER);
+        j->path = (char *)ZLIST_MALLOC(path_len);
+        if (!j->buf || !j->path || 0 != fstat(j->fd, &st))
+        {
+            ZLIST_FREE(j->buf);
+            ZLIST_FREE(j->path);
+            close(j->fd);
+            return j->buf && j->path ? Z_ERR : Z_ENOMEM;
+        }
+        memcpy(j->path, path, path_len);
+        j->cap = ZLIST_JOURNAL_BUFFER;
+        j->size = (uint64_t)st.st_size;
+        return Z_OK;
+    }
+
+    // Commits, then releases the journal. Detach it first: zlist_journal_attach(l, NULL).
+    static inline int zlist_journal_close(zlist_journal *j)
+    {
+        int rc = zlist_journal_commit(j);
+        close(j->fd);
+        ZLIST_FREE(j->buf);
+        ZLIST_FREE(j->path);
+        j->fd = -1;
+        j->buf = NULL;
+        j->path = NULL;
+        return rc;
+    }
+
+    static inline void zlist_journal_begin(zlist_journal *j, size_t elem_size)
+    {
+        zlist_journal_header h;
+        memcpy(h.magic, "ZLJR", 4);
+        h.byte_order = ZLIST_JOURNAL_BYTE_ORDER;
+        h.version = ZLIST_JOURNAL_VERSION;
+        h.reserved = 0;
+        h.elem_size = (uint32_t)elem_size;
+        memcpy(j->buf + j->len, &h, sizeof(h));
+        j->len += sizeof(h);
+    }
+
+    // Replay state: a buffered reader and an id -> node table.
+    typedef struct
+    {
+        int fd;
+        unsigned char *buf;
+        size_t cap;
+        size_t pos;
+        size_t len;
+        uint64_t offset;        // File offset of buf[0].
+        bool eof;
+        uint64_t *keys;
+        void **nodes;
+        size_t slots;           // Power of two.
+        size_t count;
+        uint64_t max_id;
+    } zlist_journal_replay_state;
+
+    // Makes at least 'need' bytes available unless the file ends first.
+    static inline int zlist_journal_fill(zlist_journal_replay_state *s, size_t need)
+    {
+        if (s->len - s->pos >= need || s->eof) return Z_OK;
+        memmove(s->buf, s->buf + s->pos, s->len - s->pos);
+        s->offset += s->pos;
+        s->len -= s->pos;
+        s->pos = 0;
+        while (s->len < need && !s->eof)
+        {
+            ssize_t n = read(s->fd, s->buf + s->len, s->cap - s->len);
+            if (n < 0)
+            {
+                if (EINTR == errno) continue;
+                return Z_ERR;
+            }
+            if (0 == n) s->eof = true;
+            s->len += (size_t)n;
+        }
+        return Z_OK;
+    }
+
+    static inline int zlist_journal_replay_open(zlist_journal_replay_state *s, const char *path,
+                                                size_t elem_size)
+    {
+        zlist_journal_header h;
+        memset(s, 0, sizeof(*s));
+        s->cap = ZLIST_JOURNAL_BUFFER > 2 * (elem_size + 25) ? ZLIST_JOURNAL_BUFFER
+                                                             : 2 * (elem_size + 25);
+        s->slots = 1024;
+        s->fd = open(path, O_RDWR);
+        if (s->fd < 0) return Z_ERR;
+        s->buf = (unsigned char *)ZLIST_MALLOC(s->cap);
+        s->keys = (uint64_t *)ZLIST_MALLOC(s->slots * sizeof(uint64_t));
+        s->nodes = (void **)ZLIST_MALLOC(s->slots * sizeof(void *));
+        if (!s->buf || !s->keys || !s->nodes) return Z_ENOMEM;
+        memset(s->keys, 0, s->slots * sizeof(uint64_t));
+        if (Z_OK != zlist_journal_fill(s, sizeof(h))) return Z_ERR;
+        if (s->len < sizeof(h)) return Z_EINVAL;
+        memcpy(&h, s->buf, sizeof(h));
+        s->pos = sizeof(h);
+        if (0 != memcmp(h.magic, "ZLJR", 4) || ZLIST_JOURNAL_BYTE_ORDER != h.byte_order ||
+            ZLIST_JOURNAL_VERSION != h.version || elem_size != h.elem_size)
+        {
+            return Z_EINVAL;
+        }
+        return Z_OK;
+    }
+
+    static inline void zlist_journal_replay_free(zlist_journal_replay_state *s)
+    {
+        if (s->fd >= 0) close(s->fd);
+        ZLIST_FREE(s->buf);
+        ZLIST_FREE(s->keys);
+        ZLIST_FREE(s->nodes);
+    }
+
+    // Cuts a torn tail off the log so later appends follow the last good record. Only a
+    // clean replay (rc == Z_OK) truncates; after a read error the tail is unknown.
+    static inline int zlist_journal_replay_close(zlist_journal_replay_state *s, int rc)
+    {
+        if (Z_OK == rc && s->fd >= 0 && 0 != ftruncate(s->fd, (off_t)(s->offset + s->pos)))
+        {
+            rc = Z_ERR;
+        }
+        zlist_journal_replay_free(s);
+        return rc;
+    }
+
+    /* * Decodes the next record. Returns 1 for a record, 0 at the end of the log or
+     * at the first incomplete or corrupt record, which is where replay stops, and
+     * Z_ERR when the file cannot be read (nothing is known about the rest of it).
+     */
+    static inline int zlist_journal_next(zlist_journal_replay_state *s, size_t elem_size,
+                                         int *op, uint64_t *a, uint64_t *b,
+                                         const unsigned char **value)
+    {
+        const unsigned char *start;
+        const unsigned char *p;
+        const unsigned char *end;
+        uint32_t crc;
+        if (Z_OK != zlist_journal_fill(s, 1 + 20 + elem_size + 4)) return Z_ERR;
+        start = s->buf + s->pos;
+        end = s->buf + s->len;
+        if (start == end) return 0;
+        *op = *start;
+        if (*op < ZLIST_JOP_LINK || *op > ZLIST_JOP_REVERSE) return 0;
+        p = zlist_journal_get_varint(start + 1, end, a);
+        if (p) p = zlist_journal_get_varint(p, end, b);
+        if (!p) return 0;
+        *value = p;
+        if (ZLIST_JOP_LINK == *op) p += elem_size;
+        if (p + 4 > end) return 0;
+        memcpy(&crc, p, 4);
+        if (crc != zlist_journal_fnv32(start, (size_t)(p - start))) return 0;
+        s->pos = (size_t)(p + 4 - s->buf);
+        return 1;
+    }
+
+    static inline size_t zlist_journal_slot(const zlist_journal_replay_state *s, uint64_t id)
+    {
+        size_t i = (size_t)((id * 0x9E3779B97F4A7C15ull) >> 32) & (s->slots - 1);
+        while (s->keys[i] && s->keys[i] != id)
+        {
+            i = (i + 1) & (s->slots - 1);
+        }
+        return i;
+    }
+
+    static inline void *zlist_journal_find(const zlist_journal_replay_state *s, uint64_t id)
+    {
+        size_t i = zlist_journal_slot(s, id);
+        return s->keys[i] ? s->nodes[i] : NULL;
+    }
+
+    static inline int zlist_journal_insert(zlist_journal_replay_state *s, uint64_t id,
+                                           void *node)
+    {
+        size_t i;
+        if (2 * (s->count + 1) > s->slots)
+        {
+            zlist_journal_replay_state grown = *s;
+            size_t k;
+            grown.slots = s->slots * 2;
+            grown.count = 0;
+            grown.keys = (uint64_t *)ZLIST_MALLOC(grown.slots * sizeof(uint64_t));
+            grown.nodes = (void **)ZLIST_MALLOC(grown.slots * sizeof(void *));
+            if (!grown.keys || !grown.nodes)
+            {
+                ZLIST_FREE(grown.keys);
+                ZLIST_FREE(grown.nodes);
+                return Z_ENOMEM;
+            }
+            memset(grown.keys, 0, grown.slots * sizeof(uint64_t));
+            for (k = 0; k < s->slots; k++)
+            {
+                if (s->keys[k])
+                {
+                    size_t dst = zlist_journal_slot(&grown, s->keys[k]);
+                    grown.keys[dst] = s->keys[k];
+                    grown.nodes[dst] = s->nodes[k];
+                }
+            }
+            ZLIST_FREE(s->keys);
+            ZLIST_FREE(s->nodes);
+            s->keys = grown.keys;
+            s->nodes = grown.nodes;
+            s->slots = grown.slots;
+        }
+        i = zlist_journal_slot(s, id);
+        if (!s->keys[i]) s->count++;
+        s->keys[i] = id;
+        s->nodes[i] = node;
+        if (id > s->max_id) s->max_id = id;
+        return Z_OK;
+    }
+
+    // Linear-probing delete: shifts later entries of the cluster back.
+    static inline void zlist_journal_erase(zlist_journal_replay_state *s, uint64_t id)
+    {
+        size_t mask = s->slots - 1;
+        size_t i = zlist_journal_slot(s, id);
+        size_t k;
+        if (!s->keys[i]) return;
+        s->keys[i] = 0;
+        s->count--;
+        for (k = (i + 1) & mask; s->keys[k]; k = (k + 1) & mask)
+        {
+            size_t home = (size_t)((s->keys[k] * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+            if (((k - home) & mask) >= ((k - i) & mask))
+            {
+                s->keys[i] = s->keys[k];
+                s->nodes[i] = s->nodes[k];
+                s->keys[k] = 0;
+                i = k;
+            }
+        }
+    }
+
+    static inline void zlist_journal_forget_all(zlist_journal_replay_state *s)
+    {
+        memset(s->keys, 0, s->slots * sizeof(uint64_t));
+        s->count = 0;
+    }
+
+    // Highest node id the log at 'path' has handed out. Reads only; nothing is truncated.
+    static inline int zlist_journal_max_id(const char *path, size_t elem_size, uint64_t *max_id)
+    {
+        zlist_journal_replay_state s;
+        const unsigned char *value;
+        uint64_t a, b;
+        int op;
+        int got = 0;
+        int rc = zlist_journal_replay_open(&s, path, elem_size);
+        *max_id = 0;
+        while (Z_OK == rc && 1 == (got = zlist_journal_next(&s, elem_size, &op, &a, &b, &value)))
+        {
+            if (ZLIST_JOP_LINK == op && b > *max_id) *max_id = b;
+        }
+        if (Z_OK == rc && got < 0) rc = got;
+        zlist_journal_replay_free(&s);
+        return rc;
+    }
 
-#ifndef ZLIST_MALLOC
-    #define ZLIST_MALLOC(sz)      Z_MALLOC(sz)
+    #define ZLIST_J_NODE_FIELD             uint64_t jid;
+    #define ZLIST_J_NODE_INIT(n)           ((n)->jid = 0)
+    #define ZLIST_J_LIST_FIELD             struct zlist_journal *journal;
+    #define ZLIST_J_LIST_INIT              , NULL
+
+    #define ZLIST_J_LINKED(l, n)                                                                \
+        do {                                                                                    \
+            if ((l)->journal)                                                                   \
+            {                                                                                   \
+                zlist_journal_linked((l)->journal, &(n)->jid,                                   \
+                                     (n)->next ? (n)->next->jid : 0,                            \
+                                     &(n)->value, sizeof((n)->value));                          \
+            }                                                                                   \
+        } while (0)
+
+    #define ZLIST_J_UNLINKED(l, n)                                                              \
+        do {                                                                                    \
+            if ((l)->journal)                                                                   \
+                zlist_journal_put((l)->journal, ZLIST_JOP_UNLINK, (n)->jid, 0, NULL, 0);        \
+        } while (0)
+
+    #define ZLIST_J_OP(l, op)                                                                   \
+        do {                                                                                    \
+            if ((l)->journal) zlist_journal_put((l)->journal, (op), 0, 0, NULL, 0);             \
+        } while (0)
+
+    // Moved nodes are new tail nodes of 'dest'; 'src' is left empty.
+    #define ZLIST_J_SPLICED(Name, dest, src)                                                    \
+        do {                                                                                    \
+            zlist_node_##Name *zlist_j_curr_ = (dest)->journal ? (src)->head : NULL;            \
+            for (; zlist_j_curr_; zlist_j_curr_ = zlist_j_curr_->next)                          \
+            {                                                                                   \
+                zlist_journal_linked((dest)->journal, &zlist_j_curr_->jid, 0,                   \
+                                     &zlist_j_curr_->value, sizeof(zlist_j_curr_->value));      \
+            }                                                                                   \
+            ZLIST_J_OP(src, ZLIST_JOP_CLEAR);                                                   \
+        } while (0)
+
+
+    #define ZLIST_GEN_JOURNAL_IMPL(T, Name)                                                     \
+        /* Starts logging 'l' to 'j' (NULL detaches). A fresh log first records the */          \
+        /* current nodes; an existing one continues after the highest id it holds, and */       \
+        /* every node of 'l' must come from replaying it (Z_EINVAL otherwise). */               \
+        static inline int zlist_journal_attach_##Name(zlist_##Name *l, zlist_journal *j)        \
+        {                                                                                       \
+            zlist_node_##Name *curr;                                                            \
+            l->journal = NULL;                                                                  \
+            if (!j) return Z_OK;                                                                \
+            if (0 == j->size && 0 == j->len)                                                    \
+            {                                                                                   \
+                zlist_journal_begin(j, sizeof(T));                                              \
+                for (curr = l->head; curr; curr = curr->next)                                   \
+                {                                                                               \
+                    zlist_journal_linked(j, &curr->jid, 0, &curr->value, sizeof(T));            \
+                }                                                                               \
+            }                                                                                   \
+            else                                                                                \
+            {                                                                                   \
+                uint64_t max_id = 0;                                                            \
+                int rc = j->size ? zlist_journal_max_id(j->path, sizeof(T), &max_id) : Z_OK;    \
+                if (Z_OK != rc) return rc;                                                      \
+                for (curr = l->head; curr; curr = curr->next)                                   \
+                {                                                                               \
+                    if (!curr->jid) return Z_EINVAL;                                            \
+                    if (curr->jid > max_id) max_id = curr->jid;                                 \
+                }                                                                               \
+                if (max_id >= j->next_id) j->next_id = max_id + 1;                              \
+            }                                                                                   \
+            l->journal = j;                                                                     \
+            return j->error;                                                                    \
+        }                                                                                       \
+                                                                                                \
+        /* Rebuilds 'l' (appending to it) from the log at 'path', stopping at a */              \
+        /* torn or corrupt tail, which is then truncated away. A read error returns */          \
+        /* Z_ERR and leaves the file alone. */                                                  \
+        static inline int zlist_journal_replay_##Name(zlist_##Name *l, const char *path)        \
+        {                                                                                       \
+            zlist_journal_replay_state s;                                                       \
+            zlist_journal *saved = l->journal;                                                  \
+            const unsigned char *value;                                                         \
+            uint64_t a, b;                                                                      \
+            int op;                                                                             \
+            int got = 0;                                                                        \
+            int rc = zlist_journal_replay_open(&s, path, sizeof(T));                            \
+            l->journal = NULL;                                                                  \
+            while (Z_OK == rc &&                                                                \
+                   1 == (got = zlist_journal_next(&s, sizeof(T), &op, &a, &b, &value)))         \
+            {                                                                                   \
+                zlist_node_##Name *n = (zlist_node_##Name *)zlist_journal_find(&s, a);          \
+                if (a && !n && ZLIST_JOP_CLEAR != op && ZLIST_JOP_REVERSE != op)                \
+                {                                                                               \
+                    rc = Z_EINVAL;                                                              \
+                }                                                                               \
+                else if (ZLIST_JOP_LINK == op)                                                  \
+                {                                                                               \
+                    T val;                                                                      \
+                    zlist_node_##Name *created;                                                 \
+                    memcpy(&val, value, sizeof(T));                                             \
+                    created = zlist_create_node_##Name(val);                                    \
+                    if (!created || Z_OK != zlist_journal_insert(&s, b, created))               \
+                    {                                                                           \
+                        if (created) zlist_free_node_##Name(created);                           \
+                        rc = Z_ENOMEM;                                                          \
+                    }                                                                           \
+                    else                                                                        \
+                    {                                                                           \
+                        created->jid = b;                                                       \
+                        zlist_link_before_##Name(l, n, created);                                \
+                    }                                                                           \
+                }                                                                               \
+                else if (ZLIST_JOP_UNLINK == op)                                                \
+                {                                                                               \
+                    zlist_journal_erase(&s, a);                                                 \
+                    zlist_remove_node_##Name(l, n);                                             \
+                }                                                                               \
+                else if (ZLIST_JOP_CLEAR == op)                                                 \
+                {                                                                               \
+                    zlist_journal_forget_all(&s);                                               \
+                    zlist_clear_##Name(l);                                                      \
+                }                                                                               \
+                else                                                                            \
+                {                                                                               \
+                    zlist_reverse_##Name(l);                                                    \
+                }                                                                               \
+            }                                                                                   \
+            if (Z_OK == rc && got < 0) rc = got;                                                \
+            l->journal = saved;                                                                 \
+            return zlist_journal_replay_close(&s, rc);                                          \
+        }                                                                                       \
+                                                                                                \
+        /* Replaces the log with one LINK record per node, written next to it and */            \
+        /* renamed over it. Buffered records are dropped: the new log covers them. */           \
+        static inline int zlist_journal_compact_##Name(zlist_##Name *l)                         \
+        {                                                                                       \
+            zlist_journal *j = l->journal;                                                      \
+            zlist_journal fresh;                                                                \
+            zlist_node_##Name *curr;                                                            \
+            size_t path_len;                                                                    \
+            char *tmp;                                                                          \
+            int rc;                                                                             \
+            if (!j) return Z_EINVAL;                                                            \
+            path_len = strlen(j->path);                                                         \
+            tmp = (char *)ZLIST_MALLOC(path_len + sizeof(".compact"));                          \
+            if (!tmp) return Z_ENOMEM;                                                          \
+            memcpy(tmp, j->path, path_len);                                                     \
+            memcpy(tmp + path_len, ".compact", sizeof(".compact"));                             \
+            unlink(tmp);                                                                        \
+            rc = zlist_journal_open(&fresh, tmp, 0);                                            \
+            if (Z_OK == rc)                                                                     \
+            {                                                                                   \
+                zlist_journal_begin(&fresh, sizeof(T));                                         \
+                for (curr = l->head; curr; curr = curr->next)                                   \
+                {                                                                               \
+                    uint64_t id;                                                                \
+                    zlist_journal_linked(&fresh, &id, 0, &curr->value, sizeof(T));              \
+                }                                                                               \
+                rc = zlist_journal_commit(&fresh);                                              \
+                if (Z_OK == rc && 0 != rename(tmp, j->path)) rc = Z_ERR;                        \
+                if (Z_OK != rc)                                                                 \
+                {                                                                               \
+                    zlist_journal_close(&fresh);                                                \
+                    unlink(tmp);                                                                \
+                }                                                                               \
+            }                                                                                   \
+            ZLIST_FREE(tmp);                                                                    \
+            if (Z_OK != rc) return rc;                                                          \
+            fresh.next_id = 1;                                                                  \
+            for (curr = l->head; curr; curr = curr->next)                                       \
+            {                                                                                   \
+                curr->jid = fresh.next_id++;                                                    \
+            }                                                                                   \
+            close(j->fd);                                                                       \
+            ZLIST_FREE(j->buf);                                                                 \
+            ZLIST_FREE(fresh.path);                                                             \
+            fresh.path = j->path;                                                               \
+            fresh.sync_every = j->sync_every;                                                   \
+            *j = fresh;                                                                         \
+            return Z_OK;                                                                        \
+        }
+
+
+
+#else
+#   define ZLIST_J_NODE_FIELD
+#   define ZLIST_J_NODE_INIT(n)   ((void)0)
+#   define ZLIST_J_LIST_FIELD
+#   define ZLIST_J_LIST_INIT
+#   define ZLIST_J_LINKED(l, n)   ((void)0)
+#   define ZLIST_J_UNLINKED(l, n) ((void)0)
+#   define ZLIST_J_OP(l, op)      ((void)0)
+#   define ZLIST_J_SPLICED(Name, dest, src) ((void)0)
+#   define ZLIST_GEN_JOURNAL_IMPL(T, Name)
+#endif
+
+/* * Snapshots (opt-in, C, GCC/Clang). A list attached to a zlist_history can hand
+ * out O(1) snapshots. Nodes are versioned instead of copied: each node carries
+ * the epoch its 'next' link was last changed and, only while a snapshot could
+ * still see the old link, a short chain of older (epoch, next) records. A reader
+ * at version v follows the live link if it is no newer than v, or else the
+ * newest record from at or before v. Freed nodes that a snapshot may still
+ * reach wait in a limbo list until every such snapshot is released.
+ *
+ * One thread mutates the lists of a history (and calls everything except the
+ * snapshot read/release functions); any number of threads may read snapshots
+ * concurrently with it. The 'next' fields are read with relaxed atomic loads and
+ * written with relaxed atomic stores (ZLIST_S_SET_NEXT), which cost a plain store.
+ */
+#if defined(ZLIST_ENABLE_SNAPSHOT) && !defined(__cplusplus)
+
+    #if !defined(__GNUC__) && !defined(__clang__)
+        #error "ZLIST_ENABLE_SNAPSHOT needs the GCC/Clang __atomic builtins."
+    #endif
+
+    // Node stamp of a node that was never linked into a list with a history.
+    #define ZLIST_HISTORY_FRESH UINT64_MAX
+
+    typedef struct zlist_history_rec
+    {
+        uint64_t from;                  // Epoch at which 'next' got this value.
+        void *next;                     // Older 'next' link.
+        struct zlist_history_rec *older;
+    } zlist_history_rec;
+
+    // Any function pointer; cast back to its real type before the call.
+    typedef void (*zlist_history_fn)(void);
+
+    // A freed node waiting in limbo, with what its list would have done with it.
+    typedef struct zlist_history_dead
+    {
+        uint64_t from;
+        void *node;
+        zlist_history_rec *older;       // The node's records.
+        void (*dispose)(void *node, zlist_history_fn release, void *ctx);
+        zlist_history_fn release;       // The list's release callback, if any.
+        void *release_ctx;
+        struct zlist_history_dead *link;
+    } zlist_history_dead;
+
+    typedef struct zlist_snapshot_base
+    {
+        struct zlist_history *history;
+        uint64_t version;
+        void *head;
+        size_t length;
+        int released;
+        struct zlist_snapshot_base *next;
+    } zlist_snapshot_base;
+
+    typedef struct zlist_history
+    {
+        uint64_t epoch;                 // Stamp of the next change.
+        uint64_t oldest;                // Versions of the live snapshots, if any.
+        uint64_t newest;
+        uint64_t broken;                // Snapshots up to this version lost a record.
+        size_t live;
+        size_t released;                // Release count from readers (atomic).
+        size_t reaped;
+        zlist_snapshot_base *snapshots; // Oldest first.
+        zlist_snapshot_base *last;
+        zlist_history_dead *limbo;      // Oldest first.
+        zlist_history_dead *limbo_tail;
+    } zlist_history;
+
+    static inline void zlist_history_init(zlist_history *h)
+    {
+        memset(h, 0, sizeof(*h));
+        h->epoch = 1;
+    }
+
+    static inline void zlist_history_free_chain(zlist_history_rec *r)
+    {
+        while (r)
+        {
+            zlist_history_rec *older = r->older;
+            ZLIST_FREE(r);
+            r = older;
+        }
+    }
+
+    // Writer side: drops released snapshots, then frees what no live one can reach.
+    static inline void zlist_history_collect(zlist_history *h)
+    {
+        zlist_snapshot_base **pp = &h->snapshots;
+        h->reaped = __atomic_load_n(&h->released, __ATOMIC_ACQUIRE);
+        h->last = NULL;
+        h->live = 0;
+        while (*pp)
+        {
+            zlist_snapshot_base *s = *pp;
+            if (__atomic_load_n(&s->released, __ATOMIC_ACQUIRE))
+            {
+                *pp = s->next;
+                ZLIST_FREE(s);
+                continue;
+            }
+            if (0 == h->live++) h->oldest = s->version;
+            h->newest = s->version;
+            h->last = s;
+            pp = &s->next;
+        }
+        while (h->limbo && (0 == h->live || h->limbo->from <= h->oldest))
+        {
+            zlist_history_dead *dead = h->limbo;
+            h->limbo = dead->link;
+            zlist_history_free_chain(dead->older);
+            dead->dispose(dead->node, dead->release, dead->release_ctx);
+            ZLIST_FREE(dead);
+        }
+        if (!h->limbo) h->limbo_tail = NULL;
+    }
+
+    static inline void zlist_history_poll(zlist_history *h)
+    {
+        if (__atomic_load_n(&h->released, __ATOMIC_ACQUIRE) != h->reaped)
+        {
+            zlist_history_collect(h);
+        }
+    }
+
+    // Called before a node's 'next' changes: keeps the old link for any snapshot
+    // that can see it, restamps the node and trims records nobody needs.
+    static inline void zlist_history_touch(zlist_history *h, uint64_t *stamp,
+                                           zlist_history_rec **hist, void *old_next)
+    {
+        zlist_history_rec *r;
+        zlist_history_rec **pp;
+        uint64_t end = h->epoch;
+        zlist_history_poll(h);
+        if (h->live && *stamp <= h->newest)
+        {
+            r = (zlist_history_rec *)ZLIST_MALLOC(sizeof(zlist_history_rec));
+            if (r)
+            {
+                r->from = *stamp;
+                r->next = old_next;
+                r->older = *hist;
+                __atomic_store_n(hist, r, __ATOMIC_RELEASE);
+            }
+            else
+            {
+                __atomic_store_n(&h->broken, h->newest, __ATOMIC_RELEASE);
+            }
+        }
+        __atomic_store_n(stamp, h->epoch, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        for (pp = hist; *pp; end = (*pp)->from, pp = &(*pp)->older)
+        {
+            if (0 == h->live || end <= h->oldest)
+            {
+                r = *pp;
+                __atomic_store_n(pp, NULL, __ATOMIC_RELEASE);
+                zlist_history_free_chain(r);
+                break;
+            }
+        }
+    }
+
+    // Called instead of freeing a node. Returns 1 if the node went to limbo, where it
+    // is later handed to dispose(node, release, ctx).
+    static inline int zlist_history_retire(zlist_history *h, uint64_t *stamp,
+                                           zlist_history_rec **hist, void *old_next,
+                                           void *node,
+                                           void (*dispose)(void *, zlist_history_fn, void *),
+                                           zlist_history_fn release, void *release_ctx)
+    {
+        zlist_history_dead *dead;
+        zlist_history_poll(h);
+        if (0 == h->live || (*stamp > h->newest && !*hist))
+        {
+            zlist_history_free_chain(*hist);
+            return 0;
+        }
+        dead = (zlist_history_dead *)ZLIST_MALLOC(sizeof(zlist_history_dead));
+        if (!dead)
+        {
+            // Cannot defer: the live snapshots may reach freed memory, so fail them.
+            __atomic_store_n(&h->broken, h->newest, __ATOMIC_RELEASE);
+            zlist_history_free_chain(*hist);
+            return 0;
+        }
+        zlist_history_touch(h, stamp, hist, old_next);
+        dead->from = *stamp;
+        dead->node = node;
+        dead->older = *hist;
+        dead->dispose = dispose;
+        dead->release = release;
+        dead->release_ctx = release_ctx;
+        dead->link = NULL;
+        if (h->limbo_tail) h->limbo_tail->link = dead;
+        else h->limbo = dead;
+        h->limbo_tail = dead;
+        return 1;
+    }
+
+    // Frees released snapshots and all limbo nodes. Every snapshot must be released.
+    static inline void zlist_history_destroy(zlist_history *h)
+    {
+        zlist_history_collect(h);
+        assert(0 == h->live && "zlist_history_destroy: a snapshot is still live");
+    }
+
+    static inline zlist_snapshot_base *zlist_history_take(zlist_history *h, void *head,
+                                                          size_t length)
+    {
+        zlist_snapshot_base *s;
+        zlist_history_poll(h);
+        s = (zlist_snapshot_base *)ZLIST_MALLOC(sizeof(zlist_snapshot_base));
+        if (!s) return NULL;
+        s->history = h;
+        s->version = h->epoch++;
+        s->head = head;
+        s->length = length;
+        s->released = 0;
+        s->next = NULL;
+        if (h->last) h->last->next = s;
+        else h->snapshots = s;
+        h->last = s;
+        if (0 == h->live++) h->oldest = s->version;
+        h->newest = s->version;
+        return s;
+    }
+
+    // Reader side: the link of a node as of the snapshot's version.
+    static inline void *zlist_history_older(zlist_history_rec *const *hist, uint64_t version)
+    {
+        const zlist_history_rec *r = __atomic_load_n(hist, __ATOMIC_ACQUIRE);
+        for (; r; r = r->older)
+        {
+            if (r->from <= version) return r->next;
+        }
+        return NULL;
+    }
+
+    static inline void zlist_snapshot_release_base(zlist_snapshot_base *s)
+    {
+        zlist_history *h;
+        if (!s) return;
+        h = s->history;
+        __atomic_store_n(&s->released, 1, __ATOMIC_RELEASE);
+        __atomic_fetch_add(&h->released, 1, __ATOMIC_RELEASE);
+    }
+
+    // False if an allocation failure cost this snapshot a record.
+    static inline bool zlist_snapshot_intact_base(const zlist_snapshot_base *s)
+    {
+        return s->version > __atomic_load_n(&s->history->broken, __ATOMIC_ACQUIRE);
+    }
+
+    #define ZLIST_S_NODE_FIELD             uint64_t sstamp; zlist_history_rec *shist;
+    #define ZLIST_S_LIST_FIELD             zlist_history *history;
+    #define ZLIST_S_LIST_INIT              , NULL
+
+    #define ZLIST_S_NODE_INIT(n)                                                                \
+        do {                                                                                    \
+            (n)->sstamp = ZLIST_HISTORY_FRESH;                                                  \
+            (n)->shist = NULL;                                                                  \
+        } while (0)
+
+    // Every list of the type pays for this, attached or not; a relaxed store is a plain mov.
+    #define ZLIST_S_SET_NEXT(n, v)         __atomic_store_n(&(n)->next, (v), __ATOMIC_RELAXED)
+
+    #define ZLIST_S_TOUCH(l, n)                                                                 \
+        do {                                                                                    \
+            if ((l)->history && (n))                                                            \
+                zlist_history_touch((l)->history, &(n)->sstamp, &(n)->shist, (n)->next);        \
+        } while (0)
+
+    #define ZLIST_RETIRE_NODE(Name, l, n)                                                       \
+        do {                                                                                    \
+            if (!(l)->history ||                                                                \
+                !zlist_history_retire((l)->history, &(n)->sstamp, &(n)->shist,                  \
+                                      (n)->next, (n), zlist_history_dispose_##Name,             \
+                                      (zlist_history_fn)ZLIST_B_RELEASE(l),                     \
+                                      ZLIST_B_RELEASE_CTX(l)))                                  \
+                ZLIST_DISPOSE_NODE(Name, l, n);                                                 \
+        } while (0)
+
+    // Limbo's ZLIST_DISPOSE_NODE: the list may be gone, so its hook travels along.
+    #define ZLIST_S_DISPOSER(Name)                                                              \
+        static inline void zlist_history_dispose_##Name(void *n, zlist_history_fn release,     \
+                                                        void *ctx)                              \
+        {                                                                                       \
+            if (release)                                                                        \
+            {                                                                                   \
+                ZLIST_M_RELEASED(Name, (zlist_node_##Name *)n);                                 \
+                ((void (*)(zlist_node_##Name *, void *))release)((zlist_node_##Name *)n, ctx);  \
+            }                                                                                   \
+            else                                                                                \
+            {                                                                                   \
+                zlist_free_node_##Name((zlist_node_##Name *)n);                                 \
+            }                                                                                   \
+        }
+
+    // Nodes from a list outside this history become visible to new snapshots only.
+    // Nodes leaving a history drop their records, and may only leave once every
+    // snapshot of it is released: 'dest' would otherwise free them past its limbo.
+    #define ZLIST_S_SPLICED(Name, dest, src)                                                    \
+        do {                                                                                    \
+            ZLIST_S_TOUCH(dest, (dest)->tail);                                                  \
+            if ((dest)->history != (src)->history)                                              \
+            {                                                                                   \
+                zlist_node_##Name *zlist_s_curr_ = (src)->head;                                 \
+                if ((src)->history) zlist_history_poll((src)->history);                         \
+                assert((!(src)->history || 0 == (src)->history->live) &&                        \
+                       "zlist_splice: release the source history's snapshots first");           \
+                for (; zlist_s_curr_; zlist_s_curr_ = zlist_s_curr_->next)                      \
+                {                                                                               \
+                    zlist_history_free_chain(zlist_s_curr_->shist);                             \
+                    zlist_s_curr_->shist = NULL;                                                \
+                    zlist_s_curr_->sstamp = (dest)->history ? (dest)->history->epoch            \
+                                                            : ZLIST_HISTORY_FRESH;              \
+                }                                                                               \
+            }                                                                                   \
+        } while (0)
+
+
+    #define ZLIST_GEN_SNAPSHOT_IMPL(T, Name)                                                    \
+        typedef struct zlist_snapshot_##Name                                                    \
+        {                                                                                       \
+            zlist_snapshot_base base;                                                           \
+        } zlist_snapshot_##Name;                                                                \
+                                                                                                \
+        /* Moves 'l' into history 'h' (NULL leaves it). Its snapshots must be released. */      \
+        static inline void zlist_history_attach_##Name(zlist_##Name *l, zlist_history *h)       \
+        {                                                                                       \
+            zlist_node_##Name *curr;                                                            \
+            for (curr = l->head; curr; curr = curr->next)                                       \
+            {                                                                                   \
+                zlist_history_free_chain(curr->shist);                                          \
+                curr->shist = NULL;                                                             \
+                curr->sstamp = h ? h->epoch : ZLIST_HISTORY_FRESH;                              \
+            }                                                                                   \
+            l->history = h;                                                                     \
+        }                                                                                       \
+                                                                                                \
+        /* O(1): records the head, the length and a version. NULL without a history. */         \
+        static inline zlist_snapshot_##Name *zlist_snapshot_take_##Name(zlist_##Name *l)        \
+        {                                                                                       \
+            if (!l->history) return NULL;                                                       \
+            return (zlist_snapshot_##Name *)zlist_history_take(l->history, l->head,             \
+                                                               l->length);                      \
+        }                                                                                       \
+                                                                                                \
+        static inline zlist_node_##Name *zlist_snapshot_head_##Name(                            \
+            const zlist_snapshot_##Name *s)                                                     \
+        {                                                                                       \
+            return (zlist_node_##Name *)s->base.head;                                           \
+        }                                                                                       \
+                                                                                                \
+        static inline zlist_node_##Name *zlist_snapshot_next_##Name(                            \
+            const zlist_snapshot_##Name *s, const zlist_node_##Name *n)                         \
+        {                                                                                       \
+            for (;;)                                                                            \
+            {                                                                                   \
+                zlist_node_##Name *next;                                                        \
+                uint64_t stamp = __atomic_load_n(&n->sstamp, __ATOMIC_ACQUIRE);                 \
+                if (stamp > s->base.version)                                                    \
+                {                                                                               \
+                    return (zlist_node_##Name *)zlist_history_older(&n->shist,                  \
+                                                                    s->base.version);           \
+                }                                                                               \
+                next = __atomic_load_n(&n->next, __ATOMIC_RELAXED);                             \
+                __atomic_thread_fence(__ATOMIC_ACQUIRE);                                        \
+                if (__atomic_load_n(&n->sstamp, __ATOMIC_RELAXED) == stamp) return next;        \
+            }                                                                                   \
+        }                                                                                       \
+                                                                                                \
+        static inline size_t zlist_snapshot_length_##Name(const zlist_snapshot_##Name *s)       \
+        {                                                                                       \
+            return s->base.length;                                                              \
+        }                                                                                       \
+                                                                                                \
+        static inline bool zlist_snapshot_intact_##Name(const zlist_snapshot_##Name *s)         \
+        {                                                                                       \
+            return zlist_snapshot_intact_base(&s->base);                                        \
+        }                                                                                       \
+                                                                                                \
+        static inline void zlist_snapshot_release_##Name(zlist_snapshot_##Name *s)              \
+        {                                                                                       \
+            zlist_snapshot_release_base(s ? &s->base : NULL);                                   \
+        }
+
+
+#else
+#   define ZLIST_S_NODE_FIELD
+#   define ZLIST_S_LIST_FIELD
+#   define ZLIST_S_LIST_INIT
+#   define ZLIST_S_NODE_INIT(n)            ((void)0)
+#   define ZLIST_S_SET_NEXT(n, v)          ((n)->next = (v))
+#   define ZLIST_S_TOUCH(l, n)             ((void)0)
+#   define ZLIST_S_SPLICED(Name, dest, src) ((void)0)
+#   define ZLIST_RETIRE_NODE(Name, l, n)   ZLIST_DISPOSE_NODE(Name, l, n)
+#   define ZLIST_S_DISPOSER(Name)
+#   define ZLIST_GEN_SNAPSHOT_IMPL(T, Name)
+#endif
+
+/* * io_uring batches (opt-in, C, Linux 5.6+). Request descriptors queue up as list
+ * nodes; zlist_uring_submit() moves them from the pending list into SQEs, with the
+ * node itself as the SQE's user_data, and zlist_uring_reap() appends each node to
+ * a completion list once its CQE arrives. Nodes are never copied or reallocated,
+ * so a request may use its own payload as the I/O buffer. The ring is driven with
+ * raw syscalls (no liburing); syscall() needs _DEFAULT_SOURCE or _GNU_SOURCE.
+ */
+#if defined(ZLIST_ENABLE_URING) && !defined(__cplusplus)
+
+    #ifndef __linux__
+        #error "ZLIST_ENABLE_URING needs Linux."
+    #endif
+
+    // Older headers lack it; the kernel only sets it on multishot requests.
+    #ifndef IORING_CQE_F_MORE
+        #define IORING_CQE_F_MORE    (1U << 1)
+    #endif
+
+    typedef struct
+    {
+        int fd;
+        unsigned sq_entries;
+        unsigned cq_entries;
+        unsigned *sq_head;
+        unsigned *sq_tail;
+        unsigned *sq_mask;
+        unsigned *sq_array;
+        struct io_uring_sqe *sqes;
+        unsigned *cq_head;
+        unsigned *cq_tail;
+        unsigned *cq_mask;
+        struct io_uring_cqe *cqes;
+        void *sq_ring;
+        void *cq_ring;
+        size_t sq_ring_size;
+        size_t cq_ring_size;
+        unsigned queued;            // In the SQ, not yet handed to the kernel.
+        unsigned inflight;          // Handed to the kernel, not yet reaped.
+        unsigned long enters;       // io_uring_enter() calls so far.
+    } zlist_uring;
+
+    static inline void zlist_uring_exit(zlist_uring *r)
+    {
+        if (r->sqes) munmap(r->sqes, r->sq_entries * sizeof(struct io_uring_sqe));
+        if (r->cq_ring && r->cq_ring != r->sq_ring) munmap(r->cq_ring, r->cq_ring_size);
+        if (r->sq_ring) munmap(r->sq_ring, r->sq_ring_size);
+        if (r->fd >= 0) close(r->fd);
+        memset(r, 0, sizeof(*r));
+        r->fd = -1;
+    }
+
+    // Sets up a ring with room for 'entries' submissions. Z_ERR if io_uring is
+    // unavailable (old kernel, seccomp, ...), with errno from the kernel.
+    static inline int zlist_uring_init(zlist_uring *r, unsigned entries)
+    {
+        struct io_uring_params p;
+        char *sq;
+        char *cq;
+        memset(r, 0, sizeof(*r));
+        memset(&p, 0, sizeof(p));
+        r->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+        if (r->fd < 0) return Z_ERR;
+        r->sq_entries = p.sq_entries;
+        r->cq_entries = p.cq_entries;
+        r->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        r->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+        if (p.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            if (r->cq_ring_size > r->sq_ring_size) r->sq_ring_size = r->cq_ring_size;
+            r->cq_ring_size = r->sq_ring_size;
+        }
+        r->sq_ring = mmap(NULL, r->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                          r->fd, IORING_OFF_SQ_RING);
+        if (MAP_FAILED == r->sq_ring)
+        {
+            r->sq_ring = NULL;
+            zlist_uring_exit(r);
+            return Z_ERR;
+        }
+        r->cq_ring = r->sq_ring;
+        if (!(p.features & IORING_FEAT_SINGLE_MMAP))
+        {
+            r->cq_ring = mmap(NULL, r->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                              r->fd, IORING_OFF_CQ_RING);
+        }
+        r->sqes = (struct io_uring_sqe *)mmap(NULL,
+                                              p.sq_entries * sizeof(struct io_uring_sqe),
+                                              PROT_READ | PROT_WRITE, MAP_SHARED, r->fd,
+                                              IORING_OFF_SQES);
+        if (MAP_FAILED == r->cq_ring || MAP_FAILED == (void *)r->sqes)
+        {
+            if (MAP_FAILED == r->cq_ring) r->cq_ring = NULL;
+            if (MAP_FAILED == (void *)r->sqes) r->sqes = NULL;
+            zlist_uring_exit(r);
+            return Z_ERR;
+        }
+        sq = (char *)r->sq_ring;
+        cq = (char *)r->cq_ring;
+        r->sq_head = (unsigned *)(sq + p.sq_off.head);
+        r->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+        r->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+        r->sq_array = (unsigned *)(sq + p.sq_off.array);
+        r->cq_head = (unsigned *)(cq + p.cq_off.head);
+        r->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+        r->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+        r->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+        return Z_OK;
+    }
+
+    // Next free SQE, cleared, or NULL if the SQ is full or the CQ could overflow.
+    static inline struct io_uring_sqe *zlist_uring_next_sqe(zlist_uring *r)
+    {
+        unsigned tail = *r->sq_tail;
+        unsigned head = __atomic_load_n(r->sq_head, __ATOMIC_ACQUIRE);
+        struct io_uring_sqe *sqe;
+        if (tail - head >= r->sq_entries) return NULL;
+        if (r->inflight + r->queued >= r->cq_entries) return NULL;
+        sqe = &r->sqes[tail & *r->sq_mask];
+        memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    static inline void zlist_uring_push_sqe(zlist_uring *r)
+    {
+        unsigned tail = *r->sq_tail;
+        r->sq_array[tail & *r->sq_mask] = tail & *r->sq_mask;
+        __atomic_store_n(r->sq_tail, tail + 1, __ATOMIC_RELEASE);
+        r->queued++;
+    }
+
+    // One io_uring_enter(): submits everything queued and, if 'wait_nr' > 0, waits
+    // for that many completions. Z_ERR with errno on failure (EINTR included).
+    static inline int zlist_uring_flush(zlist_uring *r, unsigned wait_nr)
+    {
+        long n;
+        r->enters++;
+        n = syscall(__NR_io_uring_enter, r->fd, r->queued, wait_nr,
+                    wait_nr ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+        if (n < 0) return Z_ERR;
+        r->queued -= (unsigned)n;
+        r->inflight += (unsigned)n;
+        return Z_OK;
+    }
+
+    #define ZLIST_GEN_URING_IMPL(T, Name)                                                       \
+        /* Moves requests from the head of 'pending' into SQEs; 'prep' fills in each */         \
+        /* SQE except user_data. Returns how many were queued (nothing is submitted). */        \
+        static inline unsigned zlist_uring_submit_##Name(zlist_uring *r, zlist_##Name *pending, \
+                                                         void (*prep)(T *,                      \
+                                                                      struct io_uring_sqe *))   \
+        {                                                                                       \
+            unsigned cnt = 0;                                                                   \
+            struct io_uring_sqe *sqe;                                                           \
+            while (pending->head && (sqe = zlist_uring_next_sqe(r)))                            \
+            {                                                                                   \
+                zlist_node_##Name *n = zlist_detach_node_##Name(pending, pending->head);        \
+                prep(&n->value, sqe);                                                           \
+                sqe->user_data = (uint64_t)(uintptr_t)n;                                        \
+                zlist_uring_push_sqe(r);                                                        \
+                cnt++;                                                                          \
+            }                                                                                   \
+            return cnt;                                                                         \
+        }                                                                                       \
+                                                                                                \
+        /* Appends every completed request to 'done', after 'complete' (if given) has */        \
+        /* seen its result. Returns how many were reaped. Never blocks. Multishot */            \
+        /* requests are not supported: CQEs flagged IORING_CQE_F_MORE are consumed */           \
+        /* unseen, and only the final one completes the request. */                             \
+        static inline unsigned zlist_uring_reap_##Name(zlist_uring *r, zlist_##Name *done,      \
+                                                       void (*complete)(T *, int))              \
+        {                                                                                       \
+            unsigned head = *r->cq_head;                                                        \
+            unsigned tail = __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE);                      \
+            unsigned cnt = 0;                                                                   \
+            for (; head != tail; head++)                                                        \
+            {                                                                                   \
+                const struct io_uring_cqe *cqe = &r->cqes[head & *r->cq_mask];                  \
+                zlist_node_##Name *n = (zlist_node_##Name *)(uintptr_t)cqe->user_data;          \
+                if (cqe->flags & IORING_CQE_F_MORE) continue;                                   \
+                if (complete) complete(&n->value, cqe->res);                                    \
+                zlist_link_before_##Name(done, NULL, n);                                        \
+                cnt++;                                                                          \
+            }                                                                                   \
+            __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);                               \
+            r->inflight -= cnt;                                                                 \
+            return cnt;                                                                         \
+        }                                                                                       \
+                                                                                                \
+        /* Runs every pending request to completion: each io_uring_enter() submits a */         \
+        /* full batch and waits for everything in flight. */                                    \
+        static inline int zlist_uring_run_##Name(zlist_uring *r, zlist_##Name *pending,         \
+                                                 zlist_##Name *done,                            \
+                                                 void (*prep)(T *, struct io_uring_sqe *),      \
+                                                 void (*complete)(T *, int))                    \
+        {                                                                                       \
+            while (pending->head || r->queued || r->inflight)                                   \
+            {                                                                                   \
+                zlist_uring_submit_##Name(r, pending, prep);                                    \
+                if (Z_OK != zlist_uring_flush(r, r->inflight + r->queued) && EINTR != errno)    \
+                {                                                                               \
+                    return Z_ERR;                                                               \
+                }                                                                               \
+                zlist_uring_reap_##Name(r, done, complete);                                     \
+            }                                                                                   \
+            return Z_OK;                                                                        \
+        }
+
+
+#else
+#   define ZLIST_GEN_URING_IMPL(T, Name)
 #endif
 
-#ifndef ZLIST_FREE
-    #define ZLIST_FREE(p)         Z_FREE(p)
-#endif
+/* * Tiered lists (opt-in, C). A zlist_tiered_Name keeps its newest elements in a
+ * normal list ('hot') and freezes older ones, a segment at a time, into blocks
+ * encoded by a zlist_codec. Appends only touch the hot list; iteration decodes one
+ * frozen block at a time into a buffer owned by the iterator. Codecs see a segment
+ * as a packed array of values, so frozen types must be safe to copy as bytes.
+ */
+#if defined(ZLIST_ENABLE_TIERED) && !defined(__cplusplus)
+
+    #ifndef ZLIST_TIERED_SEGMENT
+        #define ZLIST_TIERED_SEGMENT 4096
+    #endif
+
+    typedef struct
+    {
+        // Worst-case encoded size of 'count' values; 0 if elem_size is not supported.
+        size_t (*bound)(size_t count, size_t elem_size);
+        // Returns the encoded size (at most bound()).
+        size_t (*encode)(const void *values, size_t count, size_t elem_size,
+                         unsigned char *out);
+        // Returns Z_OK, or Z_EINVAL for a block that does not decode to 'count' values.
+        int (*decode)(const unsigned char *in, size_t size, size_t count, size_t elem_size,
+                      void *values);
+    } zlist_codec;
+
+    typedef struct zlist_frozen
+    {
+        struct zlist_frozen *next;
+        size_t count;
+        size_t size;
+        unsigned char data[];
+    } zlist_frozen;
+
+    static inline size_t zlist_codec_raw_bound(size_t count, size_t elem_size)
+    {
+        return count * elem_size;
+    }
+
+    static inline size_t zlist_codec_raw_encode(const void *values, size_t count,
+                                                size_t elem_size, unsigned char *out)
+    {
+        memcpy(out, values, count * elem_size);
+        return count * elem_size;
+    }
+
+    static inline int zlist_codec_raw_decode(const unsigned char *in, size_t size,
+                                             size_t count, size_t elem_size, void *values)
+    {
+        if (size != count * elem_size) return Z_EINVAL;
+        memcpy(values, in, size);
+        return Z_OK;
+    }
+
+    // Signed integers of 1, 2, 4 or 8 bytes: zigzag of the delta from the previous
+    // value as a varint, so slowly changing sequences take about a byte each.
+    static inline bool zlist_codec_int_size(size_t elem_size)
+    {
+        return 1 == elem_size || 2 == elem_size || 4 == elem_size || 8 == elem_size;
+    }
+
+    static inline size_t zlist_codec_delta_bound(size_t count, size_t elem_size)
+    {
+        return zlist_codec_int_size(elem_size) ? count * 10 : 0;
+    }
+
+    static inline int64_t zlist_codec_load_int(const unsigned char *p, size_t elem_size)
+    {
+        int8_t  i8;
+        int16_t i16;
+        int32_t i32;
+        int64_t i64;
+        switch (elem_size)
+        {
+            case 1:  memcpy(&i8, p, 1);  return i8;
+            case 2:  memcpy(&i16, p, 2); return i16;
+            case 4:  memcpy(&i32, p, 4); return i32;
+            default: memcpy(&i64, p, 8); return i64;
+        }
+    }
+
+    static inline void zlist_codec_store_int(unsigned char *p, size_t elem_size, int64_t v)
+    {
+        int8_t  i8 = (int8_t)v;
+        int16_t i16 = (int16_t)v;
+        int32_t i32 = (int32_t)v;
+        switch (elem_size)
+        {
+            case 1:  memcpy(p, &i8, 1);  break;
+            case 2:  memcpy(p, &i16, 2); break;
+            case 4:  memcpy(p, &i32, 4); break;
+            default: memcpy(p, &v, 8);   break;
+        }
+    }
+
+    static inline size_t zlist_codec_delta_encode(const void *values, size_t count,
+                                                  size_t elem_size, unsigned char *out)
+    {
+        const unsigned char *in = (const unsigned char *)values;
+        unsigned char *p = out;
+        uint64_t prev = 0;
+        size_t i;
+        if (!zlist_codec_int_size(elem_size)) return 0;
+        for (i = 0; i < count; i++, in += elem_size)
+        {
+            uint64_t v = (uint64_t)zlist_codec_load_int(in, elem_size);
+            uint64_t d = v - prev;
+            uint64_t z = (d << 1) ^ (0 - (d >> 63));
+            prev = v;
+            while (z >= 0x80)
+            {
+                *p++ = (unsigned char)(z | 0x80);
+                z >>= 7;
+            }
+            *p++ = (unsigned char)z;
+        }
+        return (size_t)(p - out);
+    }
+
+    static inline int zlist_codec_delta_decode(const unsigned char *in, size_t size,
+                                               size_t count, size_t elem_size, void *values)
+    {
+        const unsigned char *end = in + size;
+        unsigned char *out = (unsigned char *)values;
+        uint64_t prev = 0;
+        size_t i;
+        if (!zlist_codec_int_size(elem_size)) return Z_EINVAL;
+        for (i = 0; i < count; i++, out += elem_size)
+        {
+            uint64_t z = 0;
+            unsigned shift = 0;
+            for (;;)
+            {
+                if (in == end || shift > 63) return Z_EINVAL;
+                z |= (uint64_t)(*in & 0x7f) << shift;
+                shift += 7;
+                if (!(*in++ & 0x80)) break;
+            }
+            prev += (z >> 1) ^ (0 - (z & 1));
+            zlist_codec_store_int(out, elem_size, (int64_t)prev);
+        }
+        return in == end ? Z_OK : Z_EINVAL;
+    }
+
+    static const zlist_codec zlist_codec_raw =
+    {
+        zlist_codec_raw_bound, zlist_codec_raw_encode, zlist_codec_raw_decode
+    };
 
-// Safe API generator (zerror.h integration).
-#if Z_HAS_ZERROR && !defined(__cplusplus)
+    static const zlist_codec zlist_codec_delta_varint =
+    {
+        zlist_codec_delta_bound, zlist_codec_delta_encode, zlist_codec_delta_decode
+    };
 
-    static inline zerr zlist_err_impl(int code, const char* msg, 
-                                     const char* file, int line, const char* func) 
+    static inline void zlist_frozen_free_all(zlist_frozen *b)
     {
-        return zerr_create_impl(code, file, line, func, "%s", msg);
+        while (b)
+        {
+            zlist_frozen *next = b->next;
+            ZLIST_FREE(b);
+            b = next;
+        }
     }
 
-    #define ZLIST_GEN_SAFE_IMPL(T, Name)                                                        \
-        DEFINE_RESULT(T, Res_##Name)                                                            \
+    #define ZLIST_GEN_TIERED_IMPL(T, Name)                                                      \
+        typedef struct                                                                          \
+        {                                                                                       \
+            zlist_##Name hot;                                                                   \
+            zlist_frozen *cold_head;                                                            \
+            zlist_frozen *cold_tail;                                                            \
+            size_t cold_count;                                                                  \
+            size_t cold_bytes;          /* Encoded bytes held by frozen blocks. */              \
+            size_t segment;             /* Elements per frozen block. */                        \
+            size_t hot_limit;           /* Newest elements that always stay hot. */             \
+            const zlist_codec *codec;                                                           \
+        } zlist_tiered_##Name;                                                                  \
                                                                                                 \
-        static inline zres zlist_push_back_safe_##Name(zlist_##Name *l, T val,                  \
-                                                      const char* f, int ln, const char* fn)    \
+        typedef struct                                                                          \
         {                                                                                       \
-            if (Z_OK != zlist_push_back_##Name(l, val))                                         \
-            {                                                                                   \
-                return zres_err(zlist_err_impl(Z_ENOMEM, "List Push OOM", f, ln, fn));          \
-            }                                                                                   \
-            return zres_ok();                                                                   \
+            const zlist_tiered_##Name *list;                                                    \
+            const zlist_frozen *block;                                                          \
+            const zlist_node_##Name *node;                                                      \
+            T *buf;                                                                             \
+            size_t index;                                                                       \
+            size_t count;                                                                       \
+            int error;                                                                          \
+        } zlist_tiered_iter_##Name;                                                             \
+                                                                                                \
+        /* A NULL codec or zero segment picks zlist_codec_raw / ZLIST_TIERED_SEGMENT. */        \
+        /* The codec must support sizeof(T). */                                                 \
+        static inline zlist_tiered_##Name zlist_tiered_init_##Name(const zlist_codec *codec,    \
+                                                                 size_t segment,                \
+                                                                 size_t hot_limit)              \
+        {                                                                                       \
+            zlist_tiered_##Name t;                                                              \
+            memset(&t, 0, sizeof(t));                                                           \
+            t.hot = zlist_init_##Name();                                                        \
+            t.segment = segment ? segment : ZLIST_TIERED_SEGMENT;                               \
+            t.hot_limit = hot_limit;                                                            \
+            t.codec = codec ? codec : &zlist_codec_raw;                                         \
+            assert(t.codec->bound(1, sizeof(T)) && "zlist_tiered_init: codec cannot encode T"); \
+            return t;                                                                           \
         }                                                                                       \
                                                                                                 \
-        static inline zres zlist_push_front_safe_##Name(zlist_##Name *l, T val,                 \
-                                                       const char* f, int ln, const char* fn)   \
+        static inline size_t zlist_tiered_length_##Name(const zlist_tiered_##Name *t)           \
         {                                                                                       \
-            if (Z_OK != zlist_push_front_##Name(l, val))                                        \
+            return t->cold_count + t->hot.length;                                               \
+        }                                                                                       \
+                                                                                                \
+        /* Encodes the oldest 'segment' hot elements into one block. */                         \
+        static inline int zlist_tiered_freeze_##Name(zlist_tiered_##Name *t)                    \
+        {                                                                                       \
+            size_t cnt = t->segment < t->hot.length ? t->segment : t->hot.length;               \
+            size_t bound;                                                                       \
+            size_t size;                                                                        \
+            size_t i;                                                                           \
+            zlist_node_##Name *curr;                                                            \
+            zlist_frozen *b;                                                                    \
+            T *vals;                                                                            \
+            if (0 == cnt) return Z_OK;                                                          \
+            bound = t->codec->bound(cnt, sizeof(T));                                            \
+            if (0 == bound) return Z_EINVAL;                                                    \
+            vals = (T *)ZLIST_MALLOC(cnt * sizeof(T));                                          \
+            b = (zlist_frozen *)ZLIST_MALLOC(sizeof(zlist_frozen) + bound);                     \
+            if (!vals || !b)                                                                    \
             {                                                                                   \
-                return zres_err(zlist_err_impl(Z_ENOMEM, "List Push OOM", f, ln, fn));          \
+                ZLIST_FREE(vals);                                                               \
+                ZLIST_FREE(b);                                                                  \
+                return Z_ENOMEM;                                                                \
             }                                                                                   \
-            return zres_ok();                                                                   \
+            for (i = 0, curr = t->hot.head; i < cnt; i++, curr = curr->next)                    \
+            {                                                                                   \
+                vals[i] = curr->value;                                                          \
+            }                                                                                   \
+            size = t->codec->encode(vals, cnt, sizeof(T), b->data);                             \
+            ZLIST_FREE(vals);                                                                   \
+            if (size < bound)                                                                   \
+            {                                                                                   \
+                zlist_frozen *fit = (zlist_frozen *)ZLIST_REALLOC(b, sizeof(zlist_frozen)       \
+                                                                  + size);                      \
+                if (fit) b = fit;                                                               \
+            }                                                                                   \
+            b->next = NULL;                                                                     \
+            b->count = cnt;                                                                     \
+            b->size = size;                                                                     \
+            if (t->cold_tail) t->cold_tail->next = b;                                           \
+            else t->cold_head = b;                                                              \
+            t->cold_tail = b;                                                                   \
+            t->cold_count += cnt;                                                               \
+            t->cold_bytes += size;                                                              \
+            for (i = 0; i < cnt; i++)                                                           \
+            {                                                                                   \
+                zlist_pop_front_##Name(&t->hot);                                                \
+            }                                                                                   \
+            return Z_OK;                                                                        \
         }                                                                                       \
                                                                                                 \
-        static inline Res_##Name zlist_front_safe_##Name(zlist_##Name *l,                       \
-                                                        const char* f, int ln, const char* fn)  \
+        /* O(1) append; every 'segment' appends past the hot limit freeze one block. */         \
+        /* A failed freeze only leaves the block hot until the next append. */                  \
+        static inline int zlist_tiered_push_back_##Name(zlist_tiered_##Name *t, T val)          \
         {                                                                                       \
-            if (!l->head)                                                                       \
+            int rc = zlist_push_back_##Name(&t->hot, val);                                      \
+            if (Z_OK == rc && t->hot.length >= t->hot_limit + t->segment)                       \
             {                                                                                   \
-                return Res_##Name##_err(zlist_err_impl(Z_EEMPTY, "List is empty", f, ln, fn));  \
+                zlist_tiered_freeze_##Name(t);                                                  \
             }                                                                                   \
-            return Res_##Name##_ok(l->head->value);                                             \
+            return rc;                                                                          \
         }                                                                                       \
                                                                                                 \
-        static inline Res_##Name zlist_back_safe_##Name(zlist_##Name *l,                        \
-                                                       const char* f, int ln, const char* fn)   \
+        static inline void zlist_tiered_clear_##Name(zlist_tiered_##Name *t)                    \
         {                                                                                       \
-            if (!l->tail)                                                                       \
+            zlist_clear_##Name(&t->hot);                                                        \
+            zlist_frozen_free_all(t->cold_head);                                                \
+            t->cold_head = t->cold_tail = NULL;                                                 \
+            t->cold_count = t->cold_bytes = 0;                                                  \
+        }                                                                                       \
+                                                                                                \
+        static inline zlist_tiered_iter_##Name zlist_tiered_begin_##Name(                       \
+            const zlist_tiered_##Name *t)                                                       \
+        {                                                                                       \
+            zlist_tiered_iter_##Name it;                                                        \
+            memset(&it, 0, sizeof(it));                                                         \
+            it.list = t;                                                                        \
+            it.block = t->cold_head;                                                            \
+            it.node = t->hot.head;                                                              \
+            return it;                                                                          \
+        }                                                                                       \
+                                                                                                \
+        /* Next value in order (frozen blocks, then the hot list), or NULL at the end */        \
+        /* or when a block fails to decode (it->error is then set). */                          \
+        static inline const T *zlist_tiered_next_##Name(zlist_tiered_iter_##Name *it)           \
+        {                                                                                       \
+            const T *v;                                                                         \
+            if (it->index < it->count) return &it->buf[it->index++];                            \
+            if (it->block)                                                                      \
             {                                                                                   \
-                return Res_##Name##_err(zlist_err_impl(Z_EEMPTY, "List is empty", f, ln, fn));  \
+                const zlist_frozen *b = it->block;                                              \
+                if (!it->buf)                                                                   \
+                {                                                                               \
+                    it->buf = (T *)ZLIST_MALLOC(it->list->segment * sizeof(T));                 \
+                    if (!it->buf)                                                               \
+                    {                                                                           \
+                        it->error = Z_ENOMEM;                                                   \
+                        return NULL;                                                            \
+                    }                                                                           \
+                }                                                                               \
+                it->error = it->list->codec->decode(b->data, b->size, b->count, sizeof(T),      \
+                                                    it->buf);                                   \
+                if (Z_OK != it->error) return NULL;                                             \
+                it->block = b->next;                                                            \
+                it->count = b->count;                                                           \
+                it->index = 1;                                                                  \
+                return &it->buf[0];                                                             \
             }                                                                                   \
-            return Res_##Name##_ok(l->tail->value);                                             \
+            if (!it->node) return NULL;                                                         \
+            v = &it->node->value;                                                               \
+            it->node = it->node->next;                                                          \
+            return v;                                                                           \
         }                                                                                       \
                                                                                                 \
-        static inline zres zlist_pop_back_safe_##Name(zlist_##Name *l,                          \
-                                                     const char* f, int ln, const char* fn)     \
+        static inline void zlist_tiered_iter_end_##Name(zlist_tiered_iter_##Name *it)           \
         {                                                                                       \
-            if (!l->tail)                                                                       \
+            ZLIST_FREE(it->buf);                                                                \
+            it->buf = NULL;                                                                     \
+        }
+
+
+#else
+#   define ZLIST_GEN_TIERED_IMPL(T, Name)
+#endif
+
+/* * Borrowed nodes (opt-in, C). A list with a release callback never frees a
+ * node itself: pop, remove_node and clear hand every node they drop to
+ * release(node, ctx) instead of ZLIST_FREE. Nodes can then live in memory the list
+ * does not own (a DMA buffer, a message arena, an array on the stack) and be linked
+ * with zlist_link_before() or zlist_borrow_array(). Nodes made by push_* and
+ * insert_* still come from ZLIST_MALLOC and are released the same way, so the
+ * callback sees every node regardless of where it came from.
+ */
+#if defined(ZLIST_ENABLE_BORROWED) && !defined(__cplusplus)
+
+    #define ZLIST_B_LIST_FIELD(Name)                                                            \
+        void (*release)(struct zlist_node_##Name *, void *);                                    \
+        void *release_ctx;
+    #define ZLIST_B_LIST_INIT              , NULL, NULL
+    #define ZLIST_B_RELEASE(l)             ((l)->release)
+    #define ZLIST_B_RELEASE_CTX(l)         ((l)->release_ctx)
+
+    #define ZLIST_DISPOSE_NODE(Name, l, n)                                                      \
+        do {                                                                                    \
+            if ((l)->release)                                                                   \
             {                                                                                   \
-                return zres_err(zlist_err_impl(Z_EEMPTY, "List is empty", f, ln, fn));          \
+                ZLIST_M_RELEASED(Name, n);                                                      \
+                (l)->release((n), (l)->release_ctx);                                            \
             }                                                                                   \
-            zlist_pop_back_##Name(l);                                                           \
-            return zres_ok();                                                                   \
+            else                                                                                \
+            {                                                                                   \
+                zlist_free_node_##Name(n);                                                      \
+            }                                                                                   \
+        } while (0)
+
+    #define ZLIST_GEN_BORROWED_IMPL(T, Name)                                                    \
+        /* Sets the callback that takes back dropped nodes (NULL: ZLIST_FREE again). */         \
+        static inline void zlist_set_release_##Name(zlist_##Name *l,                            \
+                                                    void (*release)(zlist_node_##Name *,        \
+                                                                    void *),                    \
+                                                    void *ctx)                                  \
+        {                                                                                       \
+            l->release = release;                                                               \
+            l->release_ctx = ctx;                                                               \
         }                                                                                       \
                                                                                                 \
-        static inline zres zlist_pop_front_safe_##Name(zlist_##Name *l,                         \
-                                                      const char* f, int ln, const char* fn)    \
+        /* Appends 'count' caller-owned nodes in array order; values must be set. */            \
+        static inline void zlist_borrow_array_##Name(zlist_##Name *l, zlist_node_##Name *nodes, \
+                                                     size_t count)                              \
         {                                                                                       \
-            if (!l->head)                                                                       \
+            size_t i;                                                                           \
+            for (i = 0; i < count; i++)                                                         \
             {                                                                                   \
-                return zres_err(zlist_err_impl(Z_EEMPTY, "List is empty", f, ln, fn));          \
+                ZLIST_S_NODE_INIT(&nodes[i]);                                                   \
+                ZLIST_J_NODE_INIT(&nodes[i]);                                                   \
+                ZLIST_M_NODE_INIT(&nodes[i]);                                                   \
+                zlist_link_before_##Name(l, NULL, &nodes[i]);                                   \
             }                                                                                   \
-            zlist_pop_front_##Name(l);                                                          \
-            return zres_ok();                                                                   \
         }
 
 #else
-#   define ZLIST_GEN_SAFE_IMPL(T, Name)
+#   define ZLIST_B_LIST_FIELD(Name)
+#   define ZLIST_B_LIST_INIT
+#   define ZLIST_B_RELEASE(l)              NULL
+#   define ZLIST_B_RELEASE_CTX(l)          NULL
+#   define ZLIST_DISPOSE_NODE(Name, l, n)  zlist_free_node_##Name(n)
+#   define ZLIST_GEN_BORROWED_IMPL(T, Name)
+#endif
+
+/* * Operation statistics (opt-in, C). Each list counts its operations by kind and
+ * tracks its peak length and how far zlist_at() walked. With ZLIST_STATS_SAMPLE
+ * set to a power of two, one call in that many per list is also timed with
+ * ZLIST_STATS_CLOCK() (rdtsc on x86) into a log2 histogram per kind.
+ */
+#if defined(ZLIST_ENABLE_STATS) && !defined(__cplusplus)
+
+    #ifndef ZLIST_STATS_SAMPLE
+        #define ZLIST_STATS_SAMPLE 0
+    #endif
+    #if ZLIST_STATS_SAMPLE & (ZLIST_STATS_SAMPLE - 1)
+        #error "ZLIST_STATS_SAMPLE must be 0 or a power of two"
+    #endif
+
+    #ifndef ZLIST_STATS_CLOCK
+        #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            #define ZLIST_STATS_CLOCK() ((uint64_t)__builtin_ia32_rdtsc())
+        #elif defined(__GNUC__) && defined(__aarch64__)
+            static inline uint64_t zlist_stats_cntvct(void)
+            {
+                uint64_t v;
+                __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+                return v;
+            }
+            #define ZLIST_STATS_CLOCK() zlist_stats_cntvct()
+        #else
+            #define ZLIST_STATS_CLOCK() ((uint64_t)clock())
+        #endif
+    #endif
+
+    #define ZLIST_STATS_BUCKETS 32
+
+    enum
+    {
+        ZLIST_STAT_PUSH,    // push_back, push_front.
+        ZLIST_STAT_INSERT,  // insert_after, insert_before, link_before.
+        ZLIST_STAT_POP,     // pop_back, pop_front.
+        ZLIST_STAT_REMOVE,  // remove_node, detach_node.
+        ZLIST_STAT_SPLICE,  // Counted on the destination.
+        ZLIST_STAT_CLEAR,
+        ZLIST_STAT_REVERSE,
+        ZLIST_STAT_AT,
+        ZLIST_STAT_OPS
+    };
+
+    typedef struct
+    {
+        uint64_t count[ZLIST_STAT_OPS];
+        uint64_t at_steps;
+        size_t peak_length;
+    #if ZLIST_STATS_SAMPLE
+        uint64_t ticker;
+        // hist[op][b]: sampled calls that took [2^b, 2^(b+1)) ticks (b = 0 also holds 0).
+        uint32_t hist[ZLIST_STAT_OPS][ZLIST_STATS_BUCKETS];
+    #endif
+    } zlist_stats;
+
+    static const char *const zlist_stat_names[ZLIST_STAT_OPS] =
+    {
+        "push", "insert", "pop", "remove", "splice", "clear", "reverse", "at"
+    };
+
+    static inline void zlist_stats_note(zlist_stats *s, int op, size_t length)
+    {
+        s->count[op]++;
+        if (length > s->peak_length) s->peak_length = length;
+    }
+
+    #if ZLIST_STATS_SAMPLE
+        // Returns a start time for sampled calls, 0 for the rest.
+        static inline uint64_t zlist_stats_start(zlist_stats *s)
+        {
+            if (0 != (++s->ticker & (ZLIST_STATS_SAMPLE - 1))) return 0;
+            return ZLIST_STATS_CLOCK();
+        }
+
+        static inline void zlist_stats_stop(zlist_stats *s, int op, uint64_t t0)
+        {
+            uint64_t d;
+            int b = 0;
+            if (!t0) return;
+            d = ZLIST_STATS_CLOCK() - t0;
+            while ((d >>= 1) && b < ZLIST_STATS_BUCKETS - 1) b++;
+            s->hist[op][b]++;
+        }
+
+        // Upper bound, in ticks, of the bucket holding the given fraction of samples.
+        static inline uint64_t zlist_stats_quantile(const uint32_t *hist, uint64_t total,
+                                                    double q)
+        {
+            uint64_t seen = 0;
+            int b;
+            for (b = 0; b < ZLIST_STATS_BUCKETS; b++)
+            {
+                seen += hist[b];
+                if ((double)seen >= q * (double)total) break;
+            }
+            return (uint64_t)1 << (b < ZLIST_STATS_BUCKETS ? b + 1 : ZLIST_STATS_BUCKETS);
+        }
+
+        #define ZLIST_STAT_BEGIN(l)    uint64_t zlist_stat_t0_ = zlist_stats_start(&(l)->stats)
+        #define ZLIST_STAT_STOP(l, op) zlist_stats_stop(&(l)->stats, (op), zlist_stat_t0_)
+    #else
+        #define ZLIST_STAT_BEGIN(l)    ((void)0)
+        #define ZLIST_STAT_STOP(l, op) ((void)0)
+    #endif
+
+    static inline void zlist_stats_dump_base(const zlist_stats *s, const char *type,
+                                             const void *list, size_t length, FILE *out)
+    {
+        int op;
+        fprintf(out, "zlist_%s %p: length %zu, peak %zu\n", type, list, length,
+                s->peak_length);
+        fprintf(out, " ");
+        for (op = 0; op < ZLIST_STAT_OPS; op++)
+        {
+            fprintf(out, " %s %llu", zlist_stat_names[op], (unsigned long long)s->count[op]);
+        }
+        fprintf(out, " (at walked %llu steps)\n", (unsigned long long)s->at_steps);
+    #if ZLIST_STATS_SAMPLE
+        for (op = 0; op < ZLIST_STAT_OPS; op++)
+        {
+            uint64_t total = 0;
+            int b;
+            for (b = 0; b < ZLIST_STATS_BUCKETS; b++) total += s->hist[op][b];
+            if (!total) continue;
+            fprintf(out, "  %-8s %llu samples, p50 < %llu, p99 < %llu, max < %llu ticks\n",
+                    zlist_stat_names[op], (unsigned long long)total,
+                    (unsigned long long)zlist_stats_quantile(s->hist[op], total, 0.50),
+                    (unsigned long long)zlist_stats_quantile(s->hist[op], total, 0.99),
+                    (unsigned long long)zlist_stats_quantile(s->hist[op], total, 1.00));
+        }
+    #endif
+    }
+
+    #define ZLIST_STAT_LIST_FIELD          zlist_stats stats;
+    #if ZLIST_STATS_SAMPLE
+        #define ZLIST_STAT_LIST_INIT       , { { 0 }, 0, 0, 0, { { 0 } } }
+    #else
+        #define ZLIST_STAT_LIST_INIT       , { { 0 }, 0, 0 }
+    #endif
+    #define ZLIST_STAT_STEPS(l, n)         ((l)->stats.at_steps += (n))
+
+    #define ZLIST_STAT_END(l, op)                                                               \
+        do {                                                                                    \
+            zlist_stats_note(&(l)->stats, (op), (l)->length);                                   \
+            ZLIST_STAT_STOP(l, op);                                                             \
+        } while (0)
+
+    #define ZLIST_GEN_STATS_IMPL(T, Name)                                                       \
+        static inline void zlist_stats_reset_##Name(zlist_##Name *l)                            \
+        {                                                                                       \
+            memset(&l->stats, 0, sizeof(l->stats));                                             \
+            l->stats.peak_length = l->length;                                                   \
+        }                                                                                       \
+                                                                                                \
+        static inline void zlist_stats_dump_##Name(const zlist_##Name *l, FILE *out)            \
+        {                                                                                       \
+            zlist_stats_dump_base(&l->stats, #Name, l, l->length, out);                         \
+        }
+
+#else
+#   define ZLIST_STAT_LIST_FIELD
+#   define ZLIST_STAT_LIST_INIT
+#   define ZLIST_STAT_BEGIN(l)             ((void)0)
+#   define ZLIST_STAT_END(l, op)           ((void)0)
+#   define ZLIST_STAT_STEPS(l, n)          ((void)0)
+#   define ZLIST_GEN_STATS_IMPL(T, Name)
+#endif
+
+/* * Memory accounting (opt-in, C). Every node made or freed through a list type is
+ * counted in a per-type zlist_memory_Name record, and zlist_memory_report() prints
+ * them for all registered types. Counters are per translation unit, as the
+ * functions are static inline. A node the list allocated and then hands to a
+ * ZLIST_ENABLE_BORROWED release callback counts as freed at the hand-off; with
+ * both features on, nodes carry a byte that tells those apart from caller memory.
+ */
+#if defined(ZLIST_ENABLE_MEMORY_REPORT) && !defined(__cplusplus)
+
+    // Estimated heap footprint of one allocation (glibc-style: header, 16-byte steps).
+    #ifndef ZLIST_MEMORY_CHUNK
+        #define ZLIST_MEMORY_CHUNK(size)                                                        \
+            ((size) + sizeof(size_t) < 32 ? (size_t)32                                          \
+                                          : ((size) + sizeof(size_t) + 15) & ~(size_t)15)
+    #endif
+
+    typedef struct
+    {
+        const char *name;
+        size_t node_size;
+        size_t value_size;
+        uint64_t live;
+        uint64_t peak;
+        uint64_t allocs;
+        uint64_t frees;
+    } zlist_memory_stats;
+
+    #if defined(__GNUC__) || defined(__clang__)
+        #define ZLIST_M_ADD(c, n) __atomic_add_fetch(&(c), (n), __ATOMIC_RELAXED)
+        #define ZLIST_M_SUB(c, n) __atomic_sub_fetch(&(c), (n), __ATOMIC_RELAXED)
+    #else
+        #define ZLIST_M_ADD(c, n) ((c) += (n))
+        #define ZLIST_M_SUB(c, n) ((c) -= (n))
+    #endif
+
+    static inline void zlist_memory_alloc(zlist_memory_stats *m)
+    {
+        uint64_t live = ZLIST_M_ADD(m->live, 1);
+        ZLIST_M_ADD(m->allocs, 1);
+        // Racy maximum: concurrent lists of one type may under-report the peak slightly.
+        if (live > m->peak) m->peak = live;
+    }
+
+    static inline void zlist_memory_free(zlist_memory_stats *m)
+    {
+        ZLIST_M_SUB(m->live, 1);
+        ZLIST_M_ADD(m->frees, 1);
+    }
+
+    // Prints one row; returns the estimated live heap bytes.
+    static inline size_t zlist_memory_line(const zlist_memory_stats *m, FILE *out)
+    {
+        size_t chunk = ZLIST_MEMORY_CHUNK(m->node_size);
+        size_t heap = (size_t)m->live * chunk;
+        if (out)
+        {
+            fprintf(out, "%-16s %10llu %10llu %12llu %12llu %14zu %14zu %5.1f%%\n", m->name,
+                    (unsigned long long)m->live, (unsigned long long)m->peak,
+                    (unsigned long long)m->allocs, (unsigned long long)m->frees,
+                    (size_t)m->live * m->node_size, heap,
+                    100.0 * (double)(chunk - m->value_size) / (double)chunk);
+        }
+        return heap;
+    }
+
+    #define ZLIST_M_COUNTERS(T, Name)                                                           \
+        static zlist_memory_stats zlist_memory_##Name =                                         \
+            { #Name, sizeof(zlist_node_##Name), sizeof(T), 0, 0, 0, 0 };
+
+    #define ZLIST_M_FREED(Name)            zlist_memory_free(&zlist_memory_##Name)
+
+    #if defined(ZLIST_ENABLE_BORROWED)
+        #define ZLIST_M_NODE_FIELD         unsigned char mheap;
+        #define ZLIST_M_NODE_INIT(n)       ((n)->mheap = 0)
+        #define ZLIST_M_ALLOCATED(Name, n)                                                      \
+            ((n)->mheap = 1, zlist_memory_alloc(&zlist_memory_##Name))
+        // Leaving through a release callback: only list-allocated nodes were counted in.
+        #define ZLIST_M_RELEASED(Name, n)                                                       \
+            do {                                                                                \
+                if ((n)->mheap)                                                                 \
+                {                                                                               \
+                    (n)->mheap = 0;                                                             \
+                    ZLIST_M_FREED(Name);                                                        \
+                }                                                                               \
+            } while (0)
+    #else
+        #define ZLIST_M_NODE_FIELD
+        #define ZLIST_M_NODE_INIT(n)       ((void)0)
+        #define ZLIST_M_ALLOCATED(Name, n) zlist_memory_alloc(&zlist_memory_##Name)
+        #define ZLIST_M_RELEASED(Name, n)  ((void)0)
+    #endif
+
+#else
+#   define ZLIST_M_COUNTERS(T, Name)
+#   define ZLIST_M_NODE_FIELD
+#   define ZLIST_M_NODE_INIT(n)            ((void)0)
+#   define ZLIST_M_ALLOCATED(Name, n)      ((void)0)
+#   define ZLIST_M_FREED(Name)             ((void)0)
+#   define ZLIST_M_RELEASED(Name, n)       ((void)0)
 #endif
 
+/* * Locality report. zlist_locality_report(l) walks a list and measures how far
+ * apart consecutive nodes sit in memory. A list built in one burst is usually
+ * close to sequential; one grown over a long run of mixed allocations hops around
+ * the heap, and every hop can be a cache or TLB miss. 'pages' against 'pages_min'
+ * says how much a rebuild into fresh nodes (or a pool) would shrink the walk.
+ */
+typedef struct
+{
+    size_t nodes;
+    size_t node_size;
+    double avg_delta;       // Mean distance between neighbours, in bytes.
+    double within_line;     // Share of hops that land within 64 B.
+    double within_page;     // ... within 4 KiB.
+    double within_huge;     // ... within 2 MiB.
+    double forward;         // Share of hops to a higher address.
+    size_t pages;           // Distinct 4 KiB pages the nodes touch.
+    size_t pages_min;       // Pages the same nodes would fill if packed.
+} zlist_locality;
+
+typedef struct
+{
+    zlist_locality r;
+    double delta_sum;
+    size_t line, page, huge, fwd, changes;
+    uintptr_t last_page;
+    uintptr_t *slots;       // Open-addressed set of page numbers + 1.
+    size_t mask;
+} zlist_locality_acc;
+
+static inline void zlist_locality_begin(zlist_locality_acc *a, size_t length, size_t node_size)
+{
+    size_t cap = 16;
+    memset(a, 0, sizeof(*a));
+    a->r.node_size = node_size;
+    a->r.pages_min = (length * node_size + 4095) / 4096;
+    // Up to two pages per node; keep the set at most two thirds full.
+    while (cap < length * 3 && cap < ((size_t)-1 >> 2)) cap <<= 1;
+    a->slots = (uintptr_t *)ZLIST_MALLOC(cap * sizeof(uintptr_t));
+    if (a->slots)
+    {
+        memset(a->slots, 0, cap * sizeof(uintptr_t));
+        a->mask = cap - 1;
+    }
+}
+
+static inline void zlist_locality_page(zlist_locality_acc *a, uintptr_t page)
+{
+    size_t i;
+    if (!a->slots) return;
+    i = (size_t)(((uint64_t)page * 0x9E3779B97F4A7C15ull) >> 24) & a->mask;
+    while (a->slots[i] && a->slots[i] != page + 1) i = (i + 1) & a->mask;
+    if (!a->slots[i])
+    {
+        a->slots[i] = page + 1;
+        a->r.pages++;
+    }
+}
+
+static inline void zlist_locality_node(zlist_locality_acc *a, const void *prev, const void *node)
+{
+    uintptr_t at = (uintptr_t)node;
+    uintptr_t first = at >> 12, last = (at + a->r.node_size - 1) >> 12;
+    a->r.nodes++;
+    zlist_locality_page(a, first);
+    if (last != first) zlist_locality_page(a, last);
+    if (!prev || first != a->last_page) a->changes++;
+    a->last_page = last;
+    if (prev)
+    {
+        uintptr_t from = (uintptr_t)prev;
+        uintptr_t d = at > from ? at - from : from - at;
+        a->delta_sum += (double)d;
+        if (d <= 64) a->line++;
+        if (d <= 4096) a->page++;
+        if (d <= ((uintptr_t)2 << 20)) a->huge++;
+        if (at > from) a->fwd++;
+    }
+}
+
+static inline zlist_locality zlist_locality_end(zlist_locality_acc *a)
+{
+    size_t hops = a->r.nodes ? a->r.nodes - 1 : 0;
+    if (hops)
+    {
+        a->r.avg_delta = a->delta_sum / (double)hops;
+        a->r.within_line = (double)a->line / (double)hops;
+        a->r.within_page = (double)a->page / (double)hops;
+        a->r.within_huge = (double)a->huge / (double)hops;
+        a->r.forward = (double)a->fwd / (double)hops;
+    }
+    // Without memory for the set, count page changes along the walk (an upper bound).
+    if (!a->slots) a->r.pages = a->changes;
+    ZLIST_FREE(a->slots);
+    return a->r;
+}
+
 /* * Allocation Strategy Injection.
  * Allows C++ to use new/delete (constructors/destructors) 
  * while C uses malloc/free.
@@ -445,15 +5788,19 @@ extern "C" {
             zlist_node_##Name* n = (zlist_node_##Name*)                                 \
                                    ZLIST_MALLOC(sizeof(zlist_node_##Name));             \
             if (n) {                                                                    \
+                ZLIST_M_ALLOCATED(Name, n);                                             \
                 n->value = val;                                                         \
                 n->prev = NULL;                                                         \
                 n->next = NULL;                                                         \
+                ZLIST_S_NODE_INIT(n);                                                   \
+                ZLIST_J_NODE_INIT(n);                                                   \
             }                                                                           \
             return n;                                                                   \
         }                                                                               \
                                                                                         \
         static inline void zlist_free_node_##Name(zlist_node_##Name* n)                 \
         {                                                                               \
+            ZLIST_M_FREED(Name);                                                        \
             ZLIST_FREE(n);                                                              \
         }
 #endif
@@ -471,6 +5818,9 @@ typedef struct zlist_node_##Name
     struct zlist_node_##Name *prev;                                                 \
     struct zlist_node_##Name *next;                                                 \
     T value;                                                                        \
+    ZLIST_J_NODE_FIELD                                                              \
+    ZLIST_S_NODE_FIELD                                                              \
+    ZLIST_M_NODE_FIELD                                                              \
 } zlist_node_##Name;                                                                \
                                                                                     \
 /* List structure (container). */                                                   \
@@ -479,14 +5829,21 @@ typedef struct
     zlist_node_##Name *head;                                                        \
     zlist_node_##Name *tail;                                                        \
     size_t length;                                                                  \
+    ZLIST_J_LIST_FIELD                                                              \
+    ZLIST_S_LIST_FIELD                                                              \
+    ZLIST_B_LIST_FIELD(Name)                                                        \
+    ZLIST_STAT_LIST_FIELD                                                           \
 } zlist_##Name;                                                                     \
                                                                                     \
 /* Inject Allocation Logic (C vs C++). */                                           \
+ZLIST_M_COUNTERS(T, Name)                                                           \
 ZLIST_IMPL_ALLOC(T, Name)                                                           \
+ZLIST_S_DISPOSER(Name)                                                              \
                                                                                     \
 static inline zlist_##Name zlist_init_##Name(void)                                  \
 {                                                                                   \
-    zlist_##Name l = { NULL, NULL, 0 };                                             \
+    zlist_##Name l = { NULL, NULL, 0 ZLIST_J_LIST_INIT ZLIST_S_LIST_INIT            \
+                       ZLIST_B_LIST_INIT ZLIST_STAT_LIST_INIT };                    \
     return l;                                                                       \
 }                                                                                   \
                                                                                     \
@@ -497,13 +5854,15 @@ static inline bool zlist_is_empty_##Name(const zlist_##Name *l)
                                                                                     \
 static inline void zlist_reverse_##Name(zlist_##Name *l)                            \
 {                                                                                   \
+    ZLIST_STAT_BEGIN(l);                                                            \
     zlist_node_##Name *curr = l->head;                                              \
     zlist_node_##Name *temp = NULL;                                                 \
     while (curr)                                                                    \
     {                                                                               \
+        ZLIST_S_TOUCH(l, curr);                                                     \
         temp = curr->prev;                                                          \
         curr->prev = curr->next;                                                    \
-        curr->next = temp;                                                          \
+        ZLIST_S_SET_NEXT(curr, temp);                                               \
         curr = curr->prev;                                                          \
     }                                                                               \
     if (temp)                                                                       \
@@ -511,44 +5870,95 @@ static inline void zlist_reverse_##Name(zlist_##Name *l)
         l->tail = l->head;                                                          \
         l->head = temp->prev;                                                       \
     }                                                                               \
+    ZLIST_J_OP(l, ZLIST_JOP_REVERSE);                                               \
+    ZLIST_STAT_END(l, ZLIST_STAT_REVERSE);                                          \
+    ZLIST_P_FIRE(reverse, Name, l);                                                 \
 }                                                                                   \
                                                                                     \
 static inline zlist_node_##Name* zlist_detach_node_##Name(zlist_##Name *l,          \
                                                           zlist_node_##Name *n)     \
 {                                                                                   \
     if (!n) return NULL;                                                            \
-    if (n->prev) n->prev->next = n->next;                                           \
+    ZLIST_STAT_BEGIN(l);                                                            \
+    ZLIST_J_UNLINKED(l, n);                                                         \
+    ZLIST_S_TOUCH(l, n->prev);                                                      \
+    ZLIST_S_TOUCH(l, n);                                                            \
+    if (n->prev) ZLIST_S_SET_NEXT(n->prev, n->next);                                \
     else l->head = n->next;                                                         \
     if (n->next) n->next->prev = n->prev;                                           \
     else l->tail = n->prev;                                                         \
-    n->prev = n->next = NULL;                                                       \
+    n->prev = NULL;                                                                 \
+    ZLIST_S_SET_NEXT(n, NULL);                                                      \
     l->length--;                                                                    \
+    ZLIST_STAT_END(l, ZLIST_STAT_REMOVE);                                           \
+    ZLIST_P_FIRE(detach, Name, l);                                                  \
     return n;                                                                       \
 }                                                                                   \
                                                                                     \
+static inline void zlist_link_before_##Name(zlist_##Name *l,                        \
+                                            zlist_node_##Name *pos,                 \
+                                            zlist_node_##Name *n)                   \
+{                                                                                   \
+    ZLIST_STAT_BEGIN(l);                                                            \
+    ZLIST_S_TOUCH(l, n);                                                            \
+    if (!pos)                                                                       \
+    {                                                                               \
+        ZLIST_S_TOUCH(l, l->tail);                                                  \
+        n->prev = l->tail;                                                          \
+        ZLIST_S_SET_NEXT(n, NULL);                                                  \
+        if (l->tail) ZLIST_S_SET_NEXT(l->tail, n);                                  \
+        else l->head = n;                                                           \
+        l->tail = n;                                                                \
+    }                                                                               \
+    else                                                                            \
+    {                                                                               \
+        ZLIST_S_TOUCH(l, pos->prev);                                                \
+        n->prev = pos->prev;                                                        \
+        ZLIST_S_SET_NEXT(n, pos);                                                   \
+        if (pos->prev) ZLIST_S_SET_NEXT(pos->prev, n);                              \
+        else l->head = n;                                                           \
+        pos->prev = n;                                                              \
+    }                                                                               \
+    l->length++;                                                                    \
+    ZLIST_J_LINKED(l, n);                                                           \
+    ZLIST_STAT_END(l, ZLIST_STAT_INSERT);                                           \
+    ZLIST_P_FIRE(link, Name, l);                                                    \
+}                                                                                   \
+                                                                                    \
 static inline int zlist_push_back_##Name(zlist_##Name *l, T val)                    \
 {                                                                                   \
+    ZLIST_STAT_BEGIN(l);                                                            \
     zlist_node_##Name *n = zlist_create_node_##Name(val);                           \
     if (!n) return Z_ENOMEM;                                                        \
                                                                                     \
+    ZLIST_S_TOUCH(l, l->tail);                                                      \
+    ZLIST_S_TOUCH(l, n);                                                            \
     n->prev = l->tail;                                                              \
-    if (l->tail) l->tail->next = n;                                                 \
+    if (l->tail) ZLIST_S_SET_NEXT(l->tail, n);                                      \
     l->tail = n;                                                                    \
     if (!l->head) l->head = n;                                                      \
     l->length++;                                                                    \
+    ZLIST_J_LINKED(l, n);                                                           \
+    ZLIST_STAT_END(l, ZLIST_STAT_PUSH);                                             \
+    ZLIST_P_FIRE(push_back, Name, l);                                               \
     return Z_OK;                                                                    \
 }                                                                                   \
                                                                                     \
 static inline int zlist_push_front_##Name(zlist_##Name *l, T val)                   \
 {                                                                                   \
+    ZLIST_STAT_BEGIN(l);                                                            \
     zlist_node_##Name *n = zlist_create_node_##Name(val);                           \
     if (!n) return Z_ENOMEM;                                                        \
                                                                                     \
-    n->next = l->head;                                                              \
+    ZLIST_S_TOUCH(l, n);                                                            \
+    ZLIST_S_SET_NEXT(n, l->head);                                                   \
     if (l->head) l->head->prev = n;                                                 \
     l->head = n;                                                                    \
     if (!l->tail) l->tail = n;                                                      \
     l->length++;                                                                    \
+    ZLIST_J_LINKED(l, n);                                                           \
+    ZLIST_STAT_END(l, ZLIST_STAT_PUSH);                                             \
+    ZLIST_P_FIRE(push_front, Name, l);                                              \
     return Z_OK;                                                                    \
 }                                                                                   \
                                                                                     \
@@ -556,87 +5966,154 @@ static inline int zlist_insert_after_##Name(zlist_##Name *l,
     zlist_node_##Name *prev_node, T val)                                            \
 {                                                                                   \
     if (!prev_node) return zlist_push_front_##Name(l, val);                         \
+    ZLIST_STAT_BEGIN(l);                                                            \
     zlist_node_##Name *n = zlist_create_node_##Name(val);                           \
     if (!n) return Z_ENOMEM;                                                        \
                                                                                     \
+    ZLIST_S_TOUCH(l, prev_node);                                                    \
+    ZLIST_S_TOUCH(l, n);                                                            \
     n->prev = prev_node;                                                            \
-    n->next = prev_node->next;                                                      \
+    ZLIST_S_SET_NEXT(n, prev_node->next);                                           \
     if (prev_node->next) prev_node->next->prev = n;                                 \
     else l->tail = n;                                                               \
-    prev_node->next = n;                                                            \
+    ZLIST_S_SET_NEXT(prev_node, n);                                                 \
+    l->length++;                                                                    \
+    ZLIST_J_LINKED(l, n);                                                           \
+    ZLIST_STAT_END(l, ZLIST_STAT_INSERT);                                           \
+    ZLIST_P_FIRE(insert_after, Name, l);                                            \
+    return Z_OK;                                                                    \
+}                                                                                   \
+                                                                                    \
+static inline int zlist_insert_before_##Name(zlist_##Name *l,                       \
+    zlist_node_##Name *next_node, T val)                                            \
+{                                                                                   \
+    ZLIST_STAT_BEGIN(l);                                                            \
+    zlist_node_##Name *n = zlist_create_node_##Name(val);                           \
+    if (!n) return Z_ENOMEM;                                                        \
+                                                                                    \
+    ZLIST_S_TOUCH(l, n);                                                            \
+    if (!next_node)                                                                 \
+    {                                                                               \
+        ZLIST_S_TOUCH(l, l->tail);                                                  \
+        n->prev = l->tail;                                                          \
+        ZLIST_S_SET_NEXT(n, NULL);                                                  \
+        if (l->tail) ZLIST_S_SET_NEXT(l->tail, n);                                  \
+        else l->head = n;                                                           \
+        l->tail = n;                                                                \
+    }                                                                               \
+    else                                                                            \
+    {                                                                               \
+        ZLIST_S_TOUCH(l, next_node->prev);                                          \
+        n->prev = next_node->prev;                                                  \
+        ZLIST_S_SET_NEXT(n, next_node);                                             \
+        if (next_node->prev) ZLIST_S_SET_NEXT(next_node->prev, n);                  \
+        else l->head = n;                                                           \
+        next_node->prev = n;                                                        \
+    }                                                                               \
     l->length++;                                                                    \
+    ZLIST_J_LINKED(l, n);                                                           \
+    ZLIST_STAT_END(l, ZLIST_STAT_INSERT);                                           \
+    ZLIST_P_FIRE(insert_before, Name, l);                                           \
     return Z_OK;                                                                    \
 }                                                                                   \
                                                                                     \
 static inline void zlist_pop_back_##Name(zlist_##Name *l)                           \
 {                                                                                   \
     if (!l->tail) return;                                                           \
+    ZLIST_STAT_BEGIN(l);                                                            \
     zlist_node_##Name *old_tail = l->tail;                                          \
+    ZLIST_J_UNLINKED(l, old_tail);                                                  \
+    ZLIST_S_TOUCH(l, old_tail->prev);                                               \
     l->tail = old_tail->prev;                                                       \
-    if (l->tail) l->tail->next = NULL;                                              \
+    if (l->tail) ZLIST_S_SET_NEXT(l->tail, NULL);                                   \
     else l->head = NULL;                                                            \
-    zlist_free_node_##Name(old_tail);                                               \
+    ZLIST_RETIRE_NODE(Name, l, old_tail);                                           \
     l->length--;                                                                    \
+    ZLIST_STAT_END(l, ZLIST_STAT_POP);                                              \
+    ZLIST_P_FIRE(pop_back, Name, l);                                                \
 }                                                                                   \
                                                                                     \
 static inline void zlist_pop_front_##Name(zlist_##Name *l)                          \
 {                                                                                   \
     if (!l->head) return;                                                           \
+    ZLIST_STAT_BEGIN(l);                                                            \
     zlist_node_##Name *old_head = l->head;                                          \
+    ZLIST_J_UNLINKED(l, old_head);                                                  \
     l->head = old_head->next;                                                       \
     if (l->head) l->head->prev = NULL;                                              \
     else l->tail = NULL;                                                            \
-    zlist_free_node_##Name(old_head);                                               \
+    ZLIST_RETIRE_NODE(Name, l, old_head);                                           \
     l->length--;                                                                    \
+    ZLIST_STAT_END(l, ZLIST_STAT_POP);                                              \
+    ZLIST_P_FIRE(pop_front, Name, l);                                               \
 }                                                                                   \
                                                                                     \
 static inline void zlist_remove_node_##Name(zlist_##Name *l, zlist_node_##Name *n)  \
 {                                                                                   \
     if (!n) return;                                                                 \
-    if (n->prev) n->prev->next = n->next;                                           \
+    ZLIST_STAT_BEGIN(l);                                                            \
+    ZLIST_J_UNLINKED(l, n);                                                         \
+    ZLIST_S_TOUCH(l, n->prev);                                                      \
+    if (n->prev) ZLIST_S_SET_NEXT(n->prev, n->next);                                \
     else l->head = n->next;                                                         \
     if (n->next) n->next->prev = n->prev;                                           \
     else l->tail = n->prev;                                                         \
-    zlist_free_node_##Name(n);                                                      \
+    ZLIST_RETIRE_NODE(Name, l, n);                                                  \
     l->length--;                                                                    \
+    ZLIST_STAT_END(l, ZLIST_STAT_REMOVE);                                           \
+    ZLIST_P_FIRE(remove, Name, l);                                                  \
 }                                                                                   \
                                                                                     \
 static inline void zlist_clear_##Name(zlist_##Name *l)                              \
 {                                                                                   \
+    ZLIST_STAT_BEGIN(l);                                                            \
     zlist_node_##Name *curr = l->head;                                              \
     while (curr)                                                                    \
     {                                                                               \
         zlist_node_##Name *next = curr->next;                                       \
-        zlist_free_node_##Name(curr);                                               \
+        ZLIST_RETIRE_NODE(Name, l, curr);                                           \
         curr = next;                                                                \
     }                                                                               \
     l->head = l->tail = NULL;                                                       \
     l->length = 0;                                                                  \
+    ZLIST_J_OP(l, ZLIST_JOP_CLEAR);                                                 \
+    ZLIST_STAT_END(l, ZLIST_STAT_CLEAR);                                            \
+    ZLIST_P_FIRE(clear, Name, l);                                                   \
 }                                                                                   \
                                                                                     \
 static inline void zlist_splice_##Name(zlist_##Name *dest, zlist_##Name *src)       \
 {                                                                                   \
     if (dest == src || !src->head) return;                                          \
+    ZLIST_STAT_BEGIN(dest);                                                         \
+    ZLIST_J_SPLICED(Name, dest, src);                                               \
+    ZLIST_S_SPLICED(Name, dest, src);                                               \
     if (!dest->head)                                                                \
     {                                                                               \
-        *dest = *src;                                                               \
+        dest->head = src->head;                                                     \
+        dest->tail = src->tail;                                                     \
+        dest->length = src->length;                                                 \
     }                                                                               \
     else                                                                            \
     {                                                                               \
-        dest->tail->next = src->head;                                               \
+        ZLIST_S_SET_NEXT(dest->tail, src->head);                                    \
         src->head->prev = dest->tail;                                               \
         dest->tail = src->tail;                                                     \
         dest->length += src->length;                                                \
     }                                                                               \
     src->head = src->tail = NULL;                                                   \
     src->length = 0;                                                                \
+    ZLIST_STAT_END(dest, ZLIST_STAT_SPLICE);                                        \
+    ZLIST_P_FIRE(splice, Name, dest);                                               \
 }                                                                                   \
                                                                                     \
 static inline zlist_node_##Name *zlist_at_##Name(zlist_##Name *l, size_t index)     \
 {                                                                                   \
     if (index >= l->length) return NULL;                                            \
+    ZLIST_STAT_BEGIN(l);                                                            \
+    ZLIST_STAT_STEPS(l, index);                                                     \
     zlist_node_##Name *curr = l->head;                                              \
     while (index-- > 0) curr = curr->next;                                          \
+    ZLIST_STAT_END(l, ZLIST_STAT_AT);                                               \
     return curr;                                                                    \
 }                                                                                   \
                                                                                     \
@@ -650,16 +6127,40 @@ static inline zlist_node_##Name *zlist_tail_##Name(zlist_##Name *l)
     return l->tail;                                                                 \
 }                                                                                   \
                                                                                     \
-ZLIST_GEN_SAFE_IMPL(T, Name)
+static inline zlist_locality zlist_locality_report_##Name(const zlist_##Name *l)    \
+{                                                                                   \
+    zlist_locality_acc acc;                                                         \
+    const zlist_node_##Name *prev = NULL, *curr;                                    \
+    zlist_locality_begin(&acc, l->length, sizeof(zlist_node_##Name));               \
+    for (curr = l->head; curr; prev = curr, curr = curr->next)                      \
+    {                                                                               \
+        zlist_locality_node(&acc, prev, curr);                                      \
+    }                                                                               \
+    return zlist_locality_end(&acc);                                                \
+}                                                                                   \
+                                                                                    \
+ZLIST_GEN_SAFE_IMPL(T, Name)                                                        \
+ZLIST_GEN_IO_IMPL(T, Name)                                                          \
+ZLIST_GEN_REGION_NODE(T, Name)                                                      \
+ZLIST_GEN_MMAP_IMPL(T, Name)                                                        \
+ZLIST_GEN_SHM_IMPL(T, Name)                                                         \
+ZLIST_GEN_JOURNAL_IMPL(T, Name)                                                     \
+ZLIST_GEN_SNAPSHOT_IMPL(T, Name)                                                    \
+ZLIST_GEN_URING_IMPL(T, Name)                                                       \
+ZLIST_GEN_TIERED_IMPL(T, Name)                                                      \
+ZLIST_GEN_BORROWED_IMPL(T, Name)                                                    \
+ZLIST_GEN_STATS_IMPL(T, Name)
 
 // C Generic dispatch entries.
 #define L_IS_EMPTY_ENTRY(T, Name)               zlist_##Name*: zlist_is_empty_##Name,
 #define L_CONST_IS_EMPTY_ENTRY(T, Name) const   zlist_##Name*: zlist_is_empty_##Name,
 #define L_REVERSE_ENTRY(T, Name)                zlist_##Name*: zlist_reverse_##Name,
 #define L_DETACH_ENTRY(T, Name)                 zlist_##Name*: zlist_detach_node_##Name,
+#define L_LINK_B_ENTRY(T, Name)                 zlist_##Name*: zlist_link_before_##Name,
 #define L_PUSH_B_ENTRY(T, Name)                 zlist_##Name*: zlist_push_back_##Name,
 #define L_PUSH_F_ENTRY(T, Name)                 zlist_##Name*: zlist_push_front_##Name,
 #define L_INS_A_ENTRY(T, Name)                  zlist_##Name*: zlist_insert_after_##Name,
+#define L_INS_B_ENTRY(T, Name)                  zlist_##Name*: zlist_insert_before_##Name,
 #define L_POP_B_ENTRY(T, Name)                  zlist_##Name*: zlist_pop_back_##Name,
 #define L_POP_F_ENTRY(T, Name)                  zlist_##Name*: zlist_pop_front_##Name,
 #define L_REM_N_ENTRY(T, Name)                  zlist_##Name*: zlist_remove_node_##Name,
@@ -668,6 +6169,94 @@ ZLIST_GEN_SAFE_IMPL(T, Name)
 #define L_HEAD_ENTRY(T, Name)                   zlist_##Name*: zlist_head_##Name,
 #define L_TAIL_ENTRY(T, Name)                   zlist_##Name*: zlist_tail_##Name,
 #define L_AT_ENTRY(T, Name)                     zlist_##Name*: zlist_at_##Name,
+#define L_LOCALITY_ENTRY(T, Name)               zlist_##Name*: zlist_locality_report_##Name,
+#define L_CONST_LOCALITY_ENTRY(T, Name) const   zlist_##Name*: zlist_locality_report_##Name,
+
+#if defined(ZLIST_ENABLE_IO) && !defined(__cplusplus)
+#   define L_WRITE_ENTRY(T, Name)               zlist_##Name*: zlist_write_##Name,
+#   define L_CONST_WRITE_ENTRY(T, Name) const   zlist_##Name*: zlist_write_##Name,
+#   define L_READ_ENTRY(T, Name)                zlist_##Name*: zlist_read_##Name,
+#   define L_WRITEV_ENTRY(T, Name)              zlist_##Name*: zlist_writev_##Name,
+#   define L_SENDMSG_ENTRY(T, Name)             zlist_##Name*: zlist_sendmsg_##Name,
+#   define L_LOAD_ENTRY(T, Name)                zlist_##Name*: zlist_load_##Name,
+#endif
+
+#if defined(ZLIST_ENABLE_MMAP) && !defined(__cplusplus)
+#   define L_MM_CREATE_ENTRY(T, Name)       zlist_mmap_##Name*: zlist_mmap_create_##Name,
+#   define L_MM_OPEN_ENTRY(T, Name)         zlist_mmap_##Name*: zlist_mmap_open_##Name,
+#   define L_MM_CLOSE_ENTRY(T, Name)        zlist_mmap_##Name*: zlist_mmap_close_##Name,
+#   define L_MM_SYNC_ENTRY(T, Name)         zlist_mmap_##Name*: zlist_mmap_sync_##Name,
+#   define L_MM_LENGTH_ENTRY(T, Name)       zlist_mmap_##Name*: zlist_mmap_length_##Name,
+#   define L_MM_HEAD_ENTRY(T, Name)         zlist_mmap_##Name*: zlist_mmap_head_##Name,
+#   define L_MM_TAIL_ENTRY(T, Name)         zlist_mmap_##Name*: zlist_mmap_tail_##Name,
+#   define L_MM_NEXT_ENTRY(T, Name)         zlist_mmap_##Name*: zlist_mmap_next_##Name,
+#   define L_MM_PREV_ENTRY(T, Name)         zlist_mmap_##Name*: zlist_mmap_prev_##Name,
+#   define L_MM_NODE_ENTRY(T, Name)         zlist_mmap_##Name*: zlist_mmap_node_##Name,
+#   define L_MM_OFFSET_ENTRY(T, Name)       zlist_mmap_##Name*: zlist_mmap_offset_##Name,
+#   define L_MM_PUSH_B_ENTRY(T, Name)       zlist_mmap_##Name*: zlist_mmap_push_back_##Name,
+#   define L_MM_PUSH_F_ENTRY(T, Name)       zlist_mmap_##Name*: zlist_mmap_push_front_##Name,
+#   define L_MM_POP_B_ENTRY(T, Name)        zlist_mmap_##Name*: zlist_mmap_pop_back_##Name,
+#   define L_MM_POP_F_ENTRY(T, Name)        zlist_mmap_##Name*: zlist_mmap_pop_front_##Name,
+#   define L_MM_REM_N_ENTRY(T, Name)        zlist_mmap_##Name*: zlist_mmap_remove_node_##Name,
+#   define L_MM_CLEAR_ENTRY(T, Name)        zlist_mmap_##Name*: zlist_mmap_clear_##Name,
+#   define L_MM_CONST_LENGTH_ENTRY(T, Name) const zlist_mmap_##Name*: zlist_mmap_length_##Name,
+#endif
+
+#if defined(ZLIST_ENABLE_SHM) && !defined(__cplusplus)
+#   define L_SHM_CREATE_ENTRY(T, Name)      zlist_shm_##Name*: zlist_shm_create_##Name,
+#   define L_SHM_OPEN_ENTRY(T, Name)        zlist_shm_##Name*: zlist_shm_open_##Name,
+#   define L_SHM_CLOSE_ENTRY(T, Name)       zlist_shm_##Name*: zlist_shm_close_##Name,
+#   define L_SHM_LOCK_ENTRY(T, Name)        zlist_shm_##Name*: zlist_shm_lock_##Name,
+#   define L_SHM_UNLOCK_ENTRY(T, Name)      zlist_shm_##Name*: zlist_shm_unlock_##Name,
+#   define L_SHM_LENGTH_ENTRY(T, Name)      zlist_shm_##Name*: zlist_shm_length_##Name,
+#   define L_SHM_PUSH_B_ENTRY(T, Name)      zlist_shm_##Name*: zlist_shm_push_back_##Name,
+#   define L_SHM_PUSH_F_ENTRY(T, Name)      zlist_shm_##Name*: zlist_shm_push_front_##Name,
+#   define L_SHM_POP_B_ENTRY(T, Name)       zlist_shm_##Name*: zlist_shm_pop_back_##Name,
+#   define L_SHM_POP_F_ENTRY(T, Name)       zlist_shm_##Name*: zlist_shm_pop_front_##Name,
+#endif
+
+#if defined(ZLIST_ENABLE_JOURNAL) && !defined(__cplusplus)
+#   define L_J_ATTACH_ENTRY(T, Name)        zlist_##Name*: zlist_journal_attach_##Name,
+#   define L_J_REPLAY_ENTRY(T, Name)        zlist_##Name*: zlist_journal_replay_##Name,
+#   define L_J_COMPACT_ENTRY(T, Name)       zlist_##Name*: zlist_journal_compact_##Name,
+#endif
+
+#if defined(ZLIST_ENABLE_SNAPSHOT) && !defined(__cplusplus)
+#   define L_H_ATTACH_ENTRY(T, Name)        zlist_##Name*: zlist_history_attach_##Name,
+#   define L_SNAP_TAKE_ENTRY(T, Name)       zlist_##Name*: zlist_snapshot_take_##Name,
+#   define L_SNAP_HEAD_ENTRY(T, Name)       zlist_snapshot_##Name*: zlist_snapshot_head_##Name,
+#   define L_SNAP_NEXT_ENTRY(T, Name)       zlist_snapshot_##Name*: zlist_snapshot_next_##Name,
+#   define L_SNAP_LENGTH_ENTRY(T, Name)     zlist_snapshot_##Name*: zlist_snapshot_length_##Name,
+#   define L_SNAP_INTACT_ENTRY(T, Name)     zlist_snapshot_##Name*: zlist_snapshot_intact_##Name,
+#   define L_SNAP_RELEASE_ENTRY(T, Name)    zlist_snapshot_##Name*: zlist_snapshot_release_##Name,
+#endif
+
+#if defined(ZLIST_ENABLE_URING) && !defined(__cplusplus)
+#   define L_URING_SUBMIT_ENTRY(T, Name)    zlist_##Name*: zlist_uring_submit_##Name,
+#   define L_URING_REAP_ENTRY(T, Name)      zlist_##Name*: zlist_uring_reap_##Name,
+#   define L_URING_RUN_ENTRY(T, Name)       zlist_##Name*: zlist_uring_run_##Name,
+#endif
+
+#if defined(ZLIST_ENABLE_TIERED) && !defined(__cplusplus)
+#   define L_TIER_PUSH_B_ENTRY(T, Name)     zlist_tiered_##Name*: zlist_tiered_push_back_##Name,
+#   define L_TIER_FREEZE_ENTRY(T, Name)     zlist_tiered_##Name*: zlist_tiered_freeze_##Name,
+#   define L_TIER_CLEAR_ENTRY(T, Name)      zlist_tiered_##Name*: zlist_tiered_clear_##Name,
+#   define L_TIER_LENGTH_ENTRY(T, Name)     zlist_tiered_##Name*: zlist_tiered_length_##Name,
+#   define L_TIER_BEGIN_ENTRY(T, Name)      zlist_tiered_##Name*: zlist_tiered_begin_##Name,
+#   define L_TIER_NEXT_ENTRY(T, Name)       zlist_tiered_iter_##Name*: zlist_tiered_next_##Name,
+#   define L_TIER_ITER_END_ENTRY(T, Name)   zlist_tiered_iter_##Name*: zlist_tiered_iter_end_##Name,
+#endif
+
+#if defined(ZLIST_ENABLE_BORROWED) && !defined(__cplusplus)
+#   define L_SET_RELEASE_ENTRY(T, Name)     zlist_##Name*: zlist_set_release_##Name,
+#   define L_BORROW_ARRAY_ENTRY(T, Name)    zlist_##Name*: zlist_borrow_array_##Name,
+#endif
+
+#if defined(ZLIST_ENABLE_STATS) && !defined(__cplusplus)
+#   define L_STATS_RESET_ENTRY(T, Name)     zlist_##Name*: zlist_stats_reset_##Name,
+#   define L_STATS_DUMP_ENTRY(T, Name)      zlist_##Name*: zlist_stats_dump_##Name,
+#   define L_CONST_STATS_DUMP_ENTRY(T, Name) const zlist_##Name*: zlist_stats_dump_##Name,
+#endif
 
 #if Z_HAS_ZERROR
 #   define L_PUSH_B_SAFE_ENTRY(T, Name)  zlist_##Name*: zlist_push_back_safe_##Name,
@@ -701,6 +6290,29 @@ ZLIST_GEN_SAFE_IMPL(T, Name)
 // Execute the generator for all registered types.
 Z_ALL_LISTS(ZLIST_GENERATE_IMPL)
 
+#if defined(ZLIST_ENABLE_MEMORY_REPORT) && !defined(__cplusplus)
+    #define ZLIST_M_REPORT_LINE(T, Name)   heap += zlist_memory_line(&zlist_memory_##Name, out);
+
+    /*
+     * Prints live, peak, allocated and freed node counts per registered type, with
+     * the live node bytes, the estimated heap bytes (ZLIST_MEMORY_CHUNK) and the share
+     * of each allocation that is not the value. Returns the total estimated heap
+     * bytes; 'out' may be NULL to only compute it.
+     */
+    static inline size_t zlist_memory_report(FILE *out)
+    {
+        size_t heap = 0;
+        if (out)
+        {
+            fprintf(out, "%-16s %10s %10s %12s %12s %14s %14s %6s\n", "type", "live", "peak",
+                    "allocs", "frees", "node bytes", "heap bytes", "ovhd");
+        }
+        Z_ALL_LISTS(ZLIST_M_REPORT_LINE)
+        if (out) fprintf(out, "%-16s %77zu\n", "total", heap);
+        return heap;
+    }
+#endif
+
 // C API macros (using _Generic).
 #define zlist_init(Name)         zlist_init_##Name()
 
@@ -715,9 +6327,11 @@ Z_ALL_LISTS(ZLIST_GENERATE_IMPL)
 
 #define zlist_reverse(l)            _Generic((l),    Z_ALL_LISTS(L_REVERSE_ENTRY) default: (void)0) (l)
 #define zlist_detach_node(l, n)     _Generic((l),    Z_ALL_LISTS(L_DETACH_ENTRY)  default: (void*)0) (l, n)
+#define zlist_link_before(l, p, n)  _Generic((l),    Z_ALL_LISTS(L_LINK_B_ENTRY)  default: (void)0)   (l, p, n)
 #define zlist_push_back(l, val)     _Generic((l),    Z_ALL_LISTS(L_PUSH_B_ENTRY)  default: 0)         (l, val)
 #define zlist_push_front(l, val)    _Generic((l),    Z_ALL_LISTS(L_PUSH_F_ENTRY)  default: 0)         (l, val)
 #define zlist_insert_after(l, n, v) _Generic((l),    Z_ALL_LISTS(L_INS_A_ENTRY)   default: 0)         (l, n, v)
+#define zlist_insert_before(l, n, v) _Generic((l),   Z_ALL_LISTS(L_INS_B_ENTRY)   default: 0)         (l, n, v)
 #define zlist_pop_back(l)           _Generic((l),    Z_ALL_LISTS(L_POP_B_ENTRY)   default: (void)0)   (l)
 #define zlist_pop_front(l)          _Generic((l),    Z_ALL_LISTS(L_POP_F_ENTRY)   default: (void)0)   (l)
 #define zlist_remove_node(l, n)     _Generic((l),    Z_ALL_LISTS(L_REM_N_ENTRY)   default: (void)0)   (l, n)
@@ -727,6 +6341,129 @@ Z_ALL_LISTS(ZLIST_GENERATE_IMPL)
 #define zlist_tail(l)               _Generic((l),    Z_ALL_LISTS(L_TAIL_ENTRY)    default: (void*)0)  (l)
 #define zlist_at(l, idx)            _Generic((l),    Z_ALL_LISTS(L_AT_ENTRY)      default: (void*)0)  (l, idx)
 
+#define zlist_locality_report(l)  _Generic((l), \
+    Z_ALL_LISTS(L_LOCALITY_ENTRY)               \
+    Z_ALL_LISTS(L_CONST_LOCALITY_ENTRY)         \
+    default: (void)0) (l)
+
+#if defined(ZLIST_ENABLE_IO) && !defined(__cplusplus)
+#   define zlist_write(l, fd)  _Generic((l),    \
+        Z_ALL_LISTS(L_WRITE_ENTRY)              \
+        Z_ALL_LISTS(L_CONST_WRITE_ENTRY)        \
+        default: Z_EINVAL) (l, fd)
+
+#   define zlist_read(l, fd)   _Generic((l),    Z_ALL_LISTS(L_READ_ENTRY)    default: Z_EINVAL)  (l, fd)
+
+#   define zlist_writev(l, fd, off, to_iov, done)  \
+        _Generic((l), Z_ALL_LISTS(L_WRITEV_ENTRY) default: Z_EINVAL) (l, fd, off, to_iov, done)
+#   define zlist_sendmsg(l, fd, flags, off, to_iov, done)  \
+        _Generic((l), Z_ALL_LISTS(L_SENDMSG_ENTRY) default: Z_EINVAL) (l, fd, flags, off, to_iov, done)
+#   define zlist_load(l, fd, parse, ctx)  \
+        _Generic((l), Z_ALL_LISTS(L_LOAD_ENTRY) default: Z_EINVAL) (l, fd, parse, ctx)
+#endif
+
+#if defined(ZLIST_ENABLE_MMAP) && !defined(__cplusplus)
+#   define zlist_mmap_length(m)  _Generic((m),  \
+        Z_ALL_LISTS(L_MM_LENGTH_ENTRY)           \
+        Z_ALL_LISTS(L_MM_CONST_LENGTH_ENTRY)     \
+        default: 0) (m)
+
+#   define zlist_mmap_create(m, path, cap)  _Generic((m), Z_ALL_LISTS(L_MM_CREATE_ENTRY)   default: Z_EINVAL) (m, path, cap)
+#   define zlist_mmap_open(m, path)         _Generic((m), Z_ALL_LISTS(L_MM_OPEN_ENTRY)     default: Z_EINVAL) (m, path)
+#   define zlist_mmap_close(m)              _Generic((m), Z_ALL_LISTS(L_MM_CLOSE_ENTRY)    default: (void)0)  (m)
+#   define zlist_mmap_sync(m)               _Generic((m), Z_ALL_LISTS(L_MM_SYNC_ENTRY)     default: Z_EINVAL) (m)
+#   define zlist_mmap_head(m)               _Generic((m), Z_ALL_LISTS(L_MM_HEAD_ENTRY)     default: (void*)0) (m)
+#   define zlist_mmap_tail(m)               _Generic((m), Z_ALL_LISTS(L_MM_TAIL_ENTRY)     default: (void*)0) (m)
+#   define zlist_mmap_next(m, n)            _Generic((m), Z_ALL_LISTS(L_MM_NEXT_ENTRY)     default: (void*)0) (m, n)
+#   define zlist_mmap_prev(m, n)            _Generic((m), Z_ALL_LISTS(L_MM_PREV_ENTRY)     default: (void*)0) (m, n)
+#   define zlist_mmap_node(m, off)          _Generic((m), Z_ALL_LISTS(L_MM_NODE_ENTRY)     default: (void*)0) (m, off)
+#   define zlist_mmap_offset(m, n)          _Generic((m), Z_ALL_LISTS(L_MM_OFFSET_ENTRY)   default: 0)        (m, n)
+#   define zlist_mmap_push_back(m, val)     _Generic((m), Z_ALL_LISTS(L_MM_PUSH_B_ENTRY)   default: 0)        (m, val)
+#   define zlist_mmap_push_front(m, val)    _Generic((m), Z_ALL_LISTS(L_MM_PUSH_F_ENTRY)   default: 0)        (m, val)
+#   define zlist_mmap_pop_back(m, out)      _Generic((m), Z_ALL_LISTS(L_MM_POP_B_ENTRY)    default: 0)        (m, out)
+#   define zlist_mmap_pop_front(m, out)     _Generic((m), Z_ALL_LISTS(L_MM_POP_F_ENTRY)    default: 0)        (m, out)
+#   define zlist_mmap_remove_node(m, n)     _Generic((m), Z_ALL_LISTS(L_MM_REM_N_ENTRY)    default: (void)0)  (m, n)
+#   define zlist_mmap_clear(m)              _Generic((m), Z_ALL_LISTS(L_MM_CLEAR_ENTRY)    default: (void)0)  (m)
+
+#   define zlist_mmap_foreach_decl(Name, m, iter)                                      \
+        for (zlist_mnode_##Name *iter = zlist_mmap_head_##Name(m); iter != NULL;        \
+             iter = zlist_mmap_next_##Name(m, iter))
+
+#   if defined(__GNUC__) || defined(__clang__)
+#       define zlist_mmap_foreach(m, iter)                                              \
+            for (__typeof__(zlist_mmap_head(m)) iter = zlist_mmap_head(m); iter != NULL; \
+                 iter = zlist_mmap_next(m, iter))
+#   endif
+#endif
+
+#if defined(ZLIST_ENABLE_SHM) && !defined(__cplusplus)
+#   define zlist_shm_create(q, name, cap)   _Generic((q), Z_ALL_LISTS(L_SHM_CREATE_ENTRY)  default: Z_EINVAL) (q, name, cap)
+#   define zlist_shm_open(q, name)          _Generic((q), Z_ALL_LISTS(L_SHM_OPEN_ENTRY)    default: Z_EINVAL) (q, name)
+#   define zlist_shm_close(q)               _Generic((q), Z_ALL_LISTS(L_SHM_CLOSE_ENTRY)   default: (void)0)  (q)
+#   define zlist_shm_lock(q)                _Generic((q), Z_ALL_LISTS(L_SHM_LOCK_ENTRY)    default: Z_EINVAL) (q)
+#   define zlist_shm_unlock(q)              _Generic((q), Z_ALL_LISTS(L_SHM_UNLOCK_ENTRY)  default: (void)0)  (q)
+#   define zlist_shm_length(q)              _Generic((q), Z_ALL_LISTS(L_SHM_LENGTH_ENTRY)  default: 0)        (q)
+#   define zlist_shm_push_back(q, val)      _Generic((q), Z_ALL_LISTS(L_SHM_PUSH_B_ENTRY)  default: 0)        (q, val)
+#   define zlist_shm_push_front(q, val)     _Generic((q), Z_ALL_LISTS(L_SHM_PUSH_F_ENTRY)  default: 0)        (q, val)
+#   define zlist_shm_pop_back(q, out)       _Generic((q), Z_ALL_LISTS(L_SHM_POP_B_ENTRY)   default: 0)        (q, out)
+#   define zlist_shm_pop_front(q, out, ms)  _Generic((q), Z_ALL_LISTS(L_SHM_POP_F_ENTRY)   default: 0)        (q, out, ms)
+#endif
+
+#if defined(ZLIST_ENABLE_JOURNAL) && !defined(__cplusplus)
+#   define zlist_journal_attach(l, j)       _Generic((l), Z_ALL_LISTS(L_J_ATTACH_ENTRY)    default: Z_EINVAL) (l, j)
+#   define zlist_journal_replay(l, path)    _Generic((l), Z_ALL_LISTS(L_J_REPLAY_ENTRY)    default: Z_EINVAL) (l, path)
+#   define zlist_journal_compact(l)         _Generic((l), Z_ALL_LISTS(L_J_COMPACT_ENTRY)   default: Z_EINVAL) (l)
+#endif
+
+#if defined(ZLIST_ENABLE_SNAPSHOT) && !defined(__cplusplus)
+#   define zlist_history_attach(l, h)       _Generic((l), Z_ALL_LISTS(L_H_ATTACH_ENTRY)    default: (void)0)  (l, h)
+#   define zlist_snapshot(l)                _Generic((l), Z_ALL_LISTS(L_SNAP_TAKE_ENTRY)   default: (void*)0) (l)
+#   define zlist_snapshot_head(s)           _Generic((s), Z_ALL_LISTS(L_SNAP_HEAD_ENTRY)   default: (void*)0) (s)
+#   define zlist_snapshot_next(s, n)        _Generic((s), Z_ALL_LISTS(L_SNAP_NEXT_ENTRY)   default: (void*)0) (s, n)
+#   define zlist_snapshot_length(s)         _Generic((s), Z_ALL_LISTS(L_SNAP_LENGTH_ENTRY) default: 0)        (s)
+#   define zlist_snapshot_intact(s)         _Generic((s), Z_ALL_LISTS(L_SNAP_INTACT_ENTRY) default: 0)        (s)
+#   define zlist_snapshot_release(s)        _Generic((s), Z_ALL_LISTS(L_SNAP_RELEASE_ENTRY) default: (void)0) (s)
+
+#   define zlist_snapshot_foreach_decl(Name, s, iter)                                  \
+        for (zlist_node_##Name *iter = zlist_snapshot_head_##Name(s); iter != NULL;     \
+             iter = zlist_snapshot_next_##Name(s, iter))
+
+#   define zlist_snapshot_foreach(s, iter)                                              \
+        for (__typeof__(zlist_snapshot_head(s)) iter = zlist_snapshot_head(s); iter != NULL; \
+             iter = zlist_snapshot_next(s, iter))
+#endif
+
+#if defined(ZLIST_ENABLE_URING) && !defined(__cplusplus)
+#   define zlist_uring_submit(r, pending, prep)  \
+        _Generic((pending), Z_ALL_LISTS(L_URING_SUBMIT_ENTRY) default: 0) (r, pending, prep)
+#   define zlist_uring_reap(r, done, complete)   \
+        _Generic((done), Z_ALL_LISTS(L_URING_REAP_ENTRY) default: 0) (r, done, complete)
+#   define zlist_uring_run(r, pending, done, prep, complete)  \
+        _Generic((pending), Z_ALL_LISTS(L_URING_RUN_ENTRY) default: Z_EINVAL) (r, pending, done, prep, complete)
+#endif
+
+#if defined(ZLIST_ENABLE_TIERED) && !defined(__cplusplus)
+#   define zlist_tiered_init(Name, codec, seg, hot)  zlist_tiered_init_##Name(codec, seg, hot)
+#   define zlist_tiered_push_back(t, val)   _Generic((t), Z_ALL_LISTS(L_TIER_PUSH_B_ENTRY) default: Z_EINVAL) (t, val)
+#   define zlist_tiered_freeze(t)           _Generic((t), Z_ALL_LISTS(L_TIER_FREEZE_ENTRY) default: Z_EINVAL) (t)
+#   define zlist_tiered_clear(t)            _Generic((t), Z_ALL_LISTS(L_TIER_CLEAR_ENTRY)  default: (void)0)  (t)
+#   define zlist_tiered_length(t)           _Generic((t), Z_ALL_LISTS(L_TIER_LENGTH_ENTRY) default: 0)        (t)
+#   define zlist_tiered_begin(t)            _Generic((t), Z_ALL_LISTS(L_TIER_BEGIN_ENTRY)  default: 0)        (t)
+#   define zlist_tiered_next(it)            _Generic((it), Z_ALL_LISTS(L_TIER_NEXT_ENTRY)  default: (void*)0) (it)
+#   define zlist_tiered_iter_end(it)        _Generic((it), Z_ALL_LISTS(L_TIER_ITER_END_ENTRY) default: (void)0) (it)
+#endif
+
+#if defined(ZLIST_ENABLE_BORROWED) && !defined(__cplusplus)
+#   define zlist_set_release(l, fn, ctx)    _Generic((l), Z_ALL_LISTS(L_SET_RELEASE_ENTRY)  default: (void)0) (l, fn, ctx)
+#   define zlist_borrow_array(l, nodes, n)  _Generic((l), Z_ALL_LISTS(L_BORROW_ARRAY_ENTRY) default: (void)0) (l, nodes, n)
+#endif
+
+#if defined(ZLIST_ENABLE_STATS) && !defined(__cplusplus)
+#   define zlist_stats_reset(l)             _Generic((l), Z_ALL_LISTS(L_STATS_RESET_ENTRY) default: (void)0) (l)
+#   define zlist_stats_dump(l, out)         \
+        _Generic((l), Z_ALL_LISTS(L_STATS_DUMP_ENTRY) Z_ALL_LISTS(L_CONST_STATS_DUMP_ENTRY) default: (void)0) (l, out)
+#endif
+
 // Explicit declaration macros
 #define zlist_foreach_decl(Name, l, iter) \
     for (zlist_node_##Name *iter = (l)->head; iter != NULL; iter = iter->next)
@@ -818,6 +6555,7 @@ Z_ALL_LISTS(ZLIST_GENERATE_IMPL)
 #   define list_push_back               zlist_push_back
 #   define list_push_front              zlist_push_front
 #   define list_insert_after            zlist_insert_after
+#   define list_insert_before           zlist_insert_before
 #   define list_pop_back                zlist_pop_back
 #   define list_pop_front               zlist_pop_front
 #   define list_remove_node             zlist_remove_node
@@ -826,8 +6564,10 @@ Z_ALL_LISTS(ZLIST_GENERATE_IMPL)
 #   define list_head                    zlist_head
 #   define list_tail                    zlist_tail
 #   define list_at                      zlist_at
+#   define list_locality_report         zlist_locality_report
 #   define list_reverse                 zlist_reverse
 #   define list_detach_node             zlist_detach_node
+#   define list_link_before             zlist_link_before
 #   define list_is_empty                zlist_is_empty
 #   define list_foreach_decl            zlist_foreach_decl 
 #   define list_foreach_safe_decl       zlist_foreach_safe_decl
@@ -838,6 +6578,14 @@ Z_ALL_LISTS(ZLIST_GENERATE_IMPL)
 #   define list_foreach_rev             zlist_foreach_rev
 #   define list_foreach_rev_safe        zlist_foreach_rev_safe
 
+#   if defined(ZLIST_ENABLE_IO) && !defined(__cplusplus)
+#       define list_write            zlist_write
+#       define list_read             zlist_read
+#       define list_writev           zlist_writev
+#       define list_sendmsg          zlist_sendmsg
+#       define list_load             zlist_load
+#   endif
+
 #   if Z_HAS_ZERROR && !defined(__cplusplus)
 #       define list_push_back_safe   zlist_push_back_safe
 #       define list_push_front_safe  zlist_push_front_safe
@@ -863,9 +6611,11 @@ namespace z_list
             static constexpr auto is_empty = ::zlist_is_empty_##Name;           \
             static constexpr auto reverse = ::zlist_reverse_##Name;             \
             static constexpr auto detach = ::zlist_detach_node_##Name;          \
+            static constexpr auto link_before = ::zlist_link_before_##Name;     \
             static constexpr auto push_back = ::zlist_push_back_##Name;         \
             static constexpr auto push_front = ::zlist_push_front_##Name;       \
             static constexpr auto insert_after = ::zlist_insert_after_##Name;   \
+            static constexpr auto insert_before = ::zlist_insert_before_##Name; \
             static constexpr auto pop_back = ::zlist_pop_back_##Name;           \
             static constexpr auto pop_front = ::zlist_pop_front_##Name;         \
             static constexpr auto remove_node = ::zlist_remove_node_##Name;     \
@@ -873,6 +6623,7 @@ namespace z_list
             static constexpr auto splice = ::zlist_splice_##Name;               \
             static constexpr auto head = ::zlist_head_##Name;                   \
             static constexpr auto tail = ::zlist_tail_##Name;                   \
+            static constexpr auto at = ::zlist_at_##Name;                       \
         };
 
     Z_ALL_LISTS(ZLIST_CPP_TRAITS)
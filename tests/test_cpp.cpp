@@ -5,6 +5,10 @@
 #include <stdexcept>
 #include <iterator>
 #include <string>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <functional>
 
 struct Vec2 
 { 
@@ -16,6 +20,21 @@ struct Vec2
     }
 };
 
+// Parallel algorithms are opt-in (C++17 and later).
+#define ZLIST_ENABLE_PARALLEL
+
+// With -DZLIST_DEBUG_ITERATORS, misuse throws so the tests can observe it.
+#ifdef ZLIST_DEBUG_ITERATORS
+#define ZLIST_ITERATOR_FAIL(msg) throw std::logic_error(msg)
+#endif
+
+// Probes record into a string so the tests can check what fired.
+static std::string probe_log;
+static const void *probe_list = nullptr;
+#define ZLIST_ENABLE_PROBES
+#define ZLIST_PROBE(op, l, type, len) \
+    ((const void *)(l) == probe_list ? (void)(probe_log += std::string(#op " ") + (type) + " ") : (void)0)
+
 // Registered 'std::string' to verify memory management (RAII)
 #define REGISTER_ZLIST_TYPES(X) \
     X(int, Int)                 \
@@ -27,6 +46,38 @@ struct Vec2
 #define TEST(name) printf("[TEST] %-40s", name);
 #define PASS() std::cout << "\033[0;32mPASS\033[0m\n";
 
+// Stateful allocator that counts live allocations in a shared counter.
+template <typename T>
+struct counting_allocator
+{
+    using value_type = T;
+
+    int *live;
+
+    explicit counting_allocator(int *counter) : live(counter) {}
+
+    template <typename U>
+    counting_allocator(const counting_allocator<U> &other) : live(other.live) {}
+
+    T *allocate(size_t n)
+    {
+        ++*live;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, size_t)
+    {
+        --*live;
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const counting_allocator<U> &other) const { return live == other.live; }
+
+    template <typename U>
+    bool operator!=(const counting_allocator<U> &other) const { return live != other.live; }
+};
+
 void test_constructors() 
 {
     TEST("Constructors (Default, InitList)");
@@ -217,6 +268,664 @@ void test_complex_types()
     PASS();
 }
 
+void test_full_api()
+{
+    TEST("Insert, Resize, Assign, Remove, Swap");
+
+    z_list::list<int> l = {1, 2, 4};
+
+    // Insert before a position.
+    auto it = l.insert(std::prev(l.end()), 3);
+    assert(*it == 3);
+    l.insert(l.end(), 2, 5);
+    l.insert(l.begin(), {-1, 0});
+    int expected[] = {-1, 0, 1, 2, 3, 4, 5, 5};
+    assert(std::equal(l.begin(), l.end(), expected));
+
+    // Remove / remove_if.
+    assert(l.remove(5) == 2);
+    assert(l.remove_if([](int x) { return x < 1; }) == 2);
+    assert(l.size() == 4 && l.front() == 1);
+    assert(l.remove(l.front()) == 1); // Value aliases an element.
+    assert(l.front() == 2);
+
+    // Resize.
+    l.resize(5);
+    assert(l.size() == 5 && l.back() == 0);
+    l.resize(2);
+    assert(l.size() == 2 && l.back() == 3);
+    l.resize(4, 9);
+    assert(l.back() == 9);
+
+    // Assign reuses nodes.
+    l.assign(3, 7);
+    assert(l.size() == 3 && l.front() == 7 && l.back() == 7);
+    l.assign({1, 2, 3, 4, 5});
+    assert(l.size() == 5 && l.back() == 5);
+    l = {8, 9};
+    assert(l.size() == 2 && l.front() == 8);
+
+    // Reverse iterators.
+    z_list::list<int> r = {1, 2, 3};
+    int rev[] = {3, 2, 1};
+    assert(std::equal(r.rbegin(), r.rend(), rev));
+    assert(*r.crbegin() == 3);
+
+    // Swap.
+    l.swap(r);
+    assert(l.size() == 3 && r.size() == 2);
+    assert(l.front() == 1 && r.front() == 8);
+
+    assert(l.max_size() > 0);
+
+    PASS();
+}
+
+// Not registered: served by the generic template traits.
+struct Unregistered
+{
+    int id;
+    double weight;
+};
+
+template <typename T>
+size_t count_generic(const z_list::list<T> &l)
+{
+    size_t n = 0;
+    for (auto it = l.begin(); it != l.end(); ++it) n++;
+    return n;
+}
+
+void test_unregistered()
+{
+    TEST("Unregistered Types (Generic Traits)");
+
+    static_assert(sizeof(z_list::detail::generic_node<int>) == sizeof(zlist_node_Int), 
+                  "Generic node must match the generated layout");
+
+    z_list::list<double> d = {1.5, 2.5};
+    d.push_front(0.5);
+    assert(d.size() == 3);
+    assert(d.front() == 0.5);
+    assert(count_generic(d) == 3);
+
+    z_list::list<Unregistered> u;
+    u.push_back({1, 1.0});
+    u.push_back({2, 2.0});
+    u.reverse();
+    assert(u.front().id == 2);
+
+    // Raw trait functions on the generic layout.
+    using tr = z_list::traits<long>;
+    tr::list_type raw = tr::init();
+    assert(Z_OK == tr::push_back(&raw, 2));
+    assert(Z_OK == tr::push_front(&raw, 1));
+    assert(Z_OK == tr::insert_before(&raw, nullptr, 3));
+    assert(tr::at(&raw, 2)->value == 3);
+    tr::clear(&raw);
+    assert(tr::is_empty(&raw));
+
+    PASS();
+}
+
+void test_relocation()
+{
+    TEST("noexcept & Trivial Relocation");
+
+    using L = z_list::list<int>;
+    static_assert(noexcept(std::declval<L&>().swap(std::declval<L&>())), "swap must be noexcept");
+    static_assert(noexcept(std::declval<const L&>().size()), "size must be noexcept");
+    static_assert(noexcept(std::declval<const L&>().empty()), "empty must be noexcept");
+    static_assert(noexcept(std::declval<L&>().begin()), "begin must be noexcept");
+    static_assert(noexcept(std::declval<L&>().end()), "end must be noexcept");
+    static_assert(std::is_nothrow_move_constructible<L>::value, "move must be noexcept");
+#ifdef ZLIST_DEBUG_ITERATORS
+    static_assert(!z_list::is_trivially_relocatable<L>::value, "tracked iterators pin the list");
+#else
+    static_assert(z_list::is_trivially_relocatable<L>::value, "list must be relocatable");
+#endif
+    static_assert(!z_list::is_trivially_relocatable<std::string>::value, "string is not");
+
+    // Relocate raw storage holding lists with memcpy.
+    alignas(L) unsigned char src_buf[2 * sizeof(L)];
+    alignas(L) unsigned char dst_buf[2 * sizeof(L)];
+    L *src = reinterpret_cast<L*>(src_buf);
+    L *dst = reinterpret_cast<L*>(dst_buf);
+    ::new (src) L({1, 2, 3});
+    ::new (src + 1) L({4});
+
+    L *end = z_list::relocate(src, src + 2, dst);
+    assert(end == dst + 2);
+    assert(dst[0].size() == 3 && dst[0].back() == 3);
+    assert(dst[1].front() == 4);
+
+    // Free non-member swap.
+    swap(dst[0], dst[1]);
+    assert(dst[0].size() == 1 && dst[1].size() == 3);
+
+    dst[0].~L();
+    dst[1].~L();
+
+    PASS();
+}
+
+void test_sort()
+{
+    TEST("Sort (Stable Merge Sort)");
+
+    z_list::list<int> l = {5, 3, 9, 1, 3, 7};
+    l.sort();
+    int expected[] = {1, 3, 3, 5, 7, 9};
+    assert(std::equal(l.begin(), l.end(), expected));
+    assert(l.back() == 9);
+    assert(*std::prev(l.end()) == 9);
+
+    // Stability: equal keys keep their relative order.
+    z_list::list<Vec2> v = {{1, 0}, {0, 1}, {1, 1}, {0, 2}};
+    v.sort([](const Vec2 &a, const Vec2 &b) { return a.x < b.x; });
+    assert(v.front().y == 1 && v.back().y == 1);
+    assert(std::next(v.begin())->y == 2);
+
+    PASS();
+}
+
+template <typename L>
+static bool is_inline(const L &l, const int &x)
+{
+    const char *p = reinterpret_cast<const char*>(&x);
+    const char *base = reinterpret_cast<const char*>(&l);
+    return p >= base && p < base + sizeof(L);
+}
+
+void test_small_list()
+{
+    TEST("small_list (Inline Nodes)");
+
+    z_list::small_list<int, 3> s = {1, 2, 3};
+    for (const int &x : s)
+    {
+        assert(is_inline(s, x));
+    }
+
+    // Overflow goes to the heap, freed slots are reused.
+    s.push_back(4);
+    assert(!is_inline(s, s.back()));
+    s.pop_front();
+    s.push_front(0);
+    assert(is_inline(s, s.front()));
+    assert(s.size() == 4);
+
+    // Copy and move land in the destination's own slots.
+    z_list::small_list<int, 3> copy = s;
+    assert(is_inline(copy, copy.front()));
+    z_list::small_list<int, 3> moved = std::move(copy);
+    assert(copy.empty());
+    assert(moved.size() == 4 && moved.front() == 0 && moved.back() == 4);
+    assert(is_inline(moved, moved.front()));
+
+    // Splice and single element splice between small lists.
+    z_list::small_list<int, 3> other = {7, 8};
+    moved.splice(std::move(other));
+    assert(moved.size() == 6 && moved.back() == 8 && other.empty());
+    other.splice(other.end(), moved, moved.begin());
+    assert(other.size() == 1 && other.front() == 0);
+    assert(is_inline(other, other.front()));
+
+    swap(moved, other);
+    assert(moved.size() == 1 && other.size() == 5);
+    assert(is_inline(moved, moved.front()));
+
+    // Extracted handles own heap nodes and may outlive the small_list.
+    decltype(other)::node_type handle;
+    {
+        z_list::small_list<int, 3> scratch = {5, 6};
+        handle = scratch.extract(scratch.begin());
+        assert(scratch.size() == 1);
+    }
+    assert(handle.value() == 5 && handle.get_allocator().arena == nullptr);
+    moved.insert(moved.end(), std::move(handle));
+    assert(moved.back() == 5 && is_inline(moved, moved.back()));
+
+    // Through a plain list reference, moves, extracts and swaps leave inline nodes behind.
+    using small_base = z_list::list<int, z_list::inline_allocator<int>>;
+    small_base *outside = nullptr;
+    small_base::node_type taken;
+    small_base swapped{z_list::inline_allocator<int>(nullptr)};
+    {
+        z_list::small_list<int, 4> scratch = {1, 2, 3};
+        small_base &ref = scratch;
+        outside = new small_base(std::move(ref));
+        assert(scratch.empty());
+        scratch = {4, 5};
+        taken = ref.extract(ref.begin());
+        swapped.push_back(9);
+        swap(ref, swapped);
+        assert(scratch.size() == 1 && scratch.front() == 9 && is_inline(scratch, scratch.front()));
+    }
+    assert(outside->size() == 3 && outside->front() == 1 && outside->back() == 3);
+    assert(taken.value() == 4);
+    assert(swapped.size() == 1 && swapped.front() == 5);
+    delete outside;
+
+    static_assert(!z_list::is_trivially_relocatable<z_list::small_list<int, 3>>::value, 
+                  "small_list holds self-referencing nodes");
+
+    PASS();
+}
+
+void test_allocator()
+{
+    TEST("Allocator (Stateful, Splice)");
+
+    int live_a = 0;
+    int live_b = 0;
+    {
+        using alloc_t = counting_allocator<int>;
+        alloc_t alloc_a(&live_a);
+        alloc_t alloc_b(&live_b);
+
+        z_list::list<int, alloc_t> a(alloc_a);
+        a.push_back(1);
+        a.push_back(2);
+        a.push_front(0);
+        assert(live_a == 3);
+
+        // Copy keeps the allocator (select_on_container_copy_construction).
+        z_list::list<int, alloc_t> copy = a;
+        assert(live_a == 6);
+        assert(copy.get_allocator() == a.get_allocator());
+
+        // Move steals nodes, no allocation.
+        z_list::list<int, alloc_t> moved = std::move(copy);
+        assert(live_a == 6);
+        assert(moved.size() == 3);
+
+        // Splice between equal allocators relinks nodes.
+        a.splice(std::move(moved));
+        assert(a.size() == 6);
+        assert(live_a == 6);
+
+        // Splice between different allocators moves elements.
+        z_list::list<int, alloc_t> b(alloc_b);
+        b.push_back(7);
+        b.splice(std::move(a));
+        assert(b.size() == 7);
+        assert(b.back() == 2);
+        assert(live_a == 0);
+        assert(live_b == 7);
+
+        // Allocator-extended move into a different allocator.
+        z_list::list<int, alloc_t> c(std::move(b), alloc_a);
+        assert(c.size() == 7);
+        assert(live_a == 7);
+        assert(live_b == 0);
+    }
+    assert(live_a == 0);
+    assert(live_b == 0);
+
+    PASS();
+}
+
+void test_node_handles()
+{
+    TEST("Node Handles (Extract, Insert, Splice)");
+
+    int live = 0;
+    {
+        using alloc_t = counting_allocator<int>;
+        alloc_t alloc(&live);
+
+        z_list::list<int, alloc_t> a({1, 2, 3, 4}, alloc);
+        z_list::list<int, alloc_t> b({10, 20}, alloc);
+        assert(live == 6);
+
+        // Extract keeps the node alive without a list.
+        auto nh = a.extract(std::next(a.begin()));
+        assert(!nh.empty());
+        assert(nh.value() == 2);
+        assert(a.size() == 3);
+        assert(live == 6);
+
+        // Insert before 'pos', reusing the node.
+        auto it = b.insert(std::next(b.begin()), std::move(nh));
+        assert(nh.empty());
+        assert(*it == 2);
+        assert(b.size() == 3);
+        assert(live == 6);
+
+        // Single element splice: b = [10, 2, 20] -> a = [1, 20, 3, 4].
+        b.splice(b.end(), b, b.begin());
+        assert(b.front() == 2 && b.back() == 10);
+        a.splice(std::next(a.begin()), b, std::prev(b.end(), 2));
+        assert(a.size() == 4);
+        assert(*std::next(a.begin()) == 20);
+        assert(b.size() == 2);
+
+        // Range splice of [3, 4] to the front of b.
+        b.splice(b.begin(), a, std::next(a.begin(), 2), a.end());
+        assert(a.size() == 2 && b.size() == 4);
+        assert(b.front() == 3);
+        assert(live == 6);
+
+        // A dropped handle frees its node.
+        { auto dropped = b.extract(b.begin()); }
+        assert(live == 5);
+    }
+    assert(live == 0);
+
+    PASS();
+}
+
+#if ZLIST_HAS_RANGES
+void test_ranges()
+{
+    TEST("C++20 Ranges (Views, Sentinel)");
+
+    static_assert(std::ranges::bidirectional_range<z_list::list<int>>);
+    static_assert(std::ranges::bidirectional_range<z_list::list_view<int>>);
+    static_assert(std::ranges::view<z_list::list_view<int>>);
+    static_assert(std::ranges::sized_range<z_list::list_view<const int>>);
+    static_assert(std::ranges::borrowed_range<z_list::list_view<int>>);
+    static_assert(std::same_as<std::ranges::sentinel_t<z_list::list_view<int>>, std::default_sentinel_t>);
+
+    z_list::list<int> l = {1, 2, 3, 4, 5, 6};
+
+    int sum = 0;
+    for (int x : l.view())
+    {
+        sum += x;
+    }
+    assert(sum == 21);
+    assert(l.view().size() == 6);
+
+    // A view follows the list: its size and its elements agree after any change.
+    auto v = l.view();
+    l.push_back(7);
+    assert(v.size() == 7 && std::ranges::distance(v) == 7);
+    l.push_front(0);
+    assert(v.size() == 8 && std::ranges::distance(v) == 8 && *v.begin() == 0);
+    l.pop_front();
+    l.pop_back();
+    assert(v.size() == 6 && std::ranges::distance(v) == 6 && *v.begin() == 1);
+    {
+        z_list::list<int> m(std::move(l));
+        assert(v.size() == 0 && v.begin() == v.end());
+        l = std::move(m);
+    }
+    assert(v.size() == 6 && std::ranges::distance(v) == 6);
+
+    // Lazy pipeline straight over the nodes.
+    auto evens = l.view() | std::views::filter([](int x) { return x % 2 == 0; })
+                          | std::views::transform([](int x) { return x * 10; });
+    int expected[] = {20, 40, 60};
+    assert(std::ranges::equal(evens, expected));
+
+    // The list itself also works with range algorithms and adaptors.
+    assert(std::ranges::find(l, 4) != l.end());
+    assert(std::ranges::distance(l | std::views::reverse) == 6);
+
+    // Range-taking members.
+    int more[] = {7, 8};
+    l.append_range(more);
+    l.prepend_range(std::views::iota(-1, 1));
+    assert(l.size() == 10 && l.front() == -1 && l.back() == 8);
+    l.insert_range(std::next(l.begin()), std::vector<int>{100});
+    assert(*std::next(l.begin()) == 100);
+    l.assign_range(std::views::iota(0, 3));
+    assert(l.size() == 3 && l.back() == 2);
+
+    const z_list::list<int> &cl = l;
+    assert(std::ranges::count_if(cl.view(), [](int x) { return x > 0; }) == 2);
+
+    PASS();
+}
+#endif
+
+#if ZLIST_HAS_COROUTINES
+// Eager fire-and-forget coroutine for driving the queue in tests.
+struct test_task
+{
+    struct promise_type
+    {
+        test_task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+test_task consume(z_list::async_queue<int> &q, std::vector<int> &out, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        out.push_back(co_await q.pop());
+    }
+}
+
+z_list::generator<int> squares(int n)
+{
+    for (int i = 1; i <= n; i++)
+    {
+        co_yield i * i;
+    }
+}
+
+void test_coroutines()
+{
+    TEST("Coroutines (async_queue, generator)");
+
+    z_list::async_queue<int> q;
+    std::vector<int> a;
+    std::vector<int> b;
+
+    // Both consumers suspend on the empty queue.
+    consume(q, a, 2);
+    consume(q, b, 1);
+    assert(q.has_waiters());
+    assert(a.empty() && b.empty());
+
+    // Each push resumes the oldest waiter inline.
+    q.push_back(1);
+    assert(a.size() == 1 && a[0] == 1);
+    q.push_back(2);
+    assert(b.size() == 1 && b[0] == 2);
+    q.push_back(3);
+    assert(a.size() == 2 && a[1] == 3);
+    assert(!q.has_waiters() && q.empty());
+
+    // Ready path: no suspension when items are queued.
+    q.push_back(4);
+    std::vector<int> c;
+    consume(q, c, 1);
+    assert(c.size() == 1 && c[0] == 4);
+
+    int out = 0;
+    assert(!q.try_pop(out));
+
+    // Generators.
+    z_list::list<int> l = {1, 2, 3};
+    int sum = 0;
+    for (const int &x : z_list::stream(l))
+    {
+        sum += x;
+    }
+    assert(sum == 6);
+
+    int sq = 0;
+    for (int x : squares(3) | std::views::filter([](int v) { return v > 1; }))
+    {
+        sq += x;
+    }
+    assert(sq == 13);
+
+    PASS();
+}
+#endif
+
+#if ZLIST_HAS_PARALLEL
+void test_parallel()
+{
+    TEST("Parallel Algorithms (std::execution)");
+
+    const int n = 100000;
+    z_list::list<int> l;
+    for (int i = 0; i < n; i++)
+    {
+        l.push_back((i * 7919) % n);
+    }
+
+    z_list::for_each(std::execution::par, l, [](int &x) { x += 1; });
+    long long sum = z_list::transform_reduce(std::execution::par, l, 0LL, std::plus<long long>(),
+                                             [](int x) { return (long long)x; });
+    assert(sum == (long long)n * (n + 1) / 2);
+    assert(z_list::count_if(std::execution::par, l, [](int x) { return x % 2 == 0; }) == n / 2);
+    assert(z_list::count_if(std::execution::seq, l, [](int x) { return x <= 10; }) == 10);
+
+    z_list::sort(std::execution::par, l);
+    assert(l.size() == (size_t)n);
+    assert(std::is_sorted(l.begin(), l.end()));
+    assert(l.front() == 1 && l.back() == n);
+    assert(*std::prev(l.end()) == n);
+
+    z_list::sort(std::execution::par, l, [](int a, int b) { return a > b; });
+    assert(l.front() == n && l.back() == 1);
+
+    PASS();
+}
+#endif
+
+#ifdef ZLIST_DEBUG_ITERATORS
+template <typename F>
+bool rejects(F f)
+{
+    try
+    {
+        f();
+    }
+    catch (const std::logic_error &)
+    {
+        return true;
+    }
+    return false;
+}
+
+void test_debug_iterators()
+{
+    TEST("Debug Iterators (Invalidation)");
+
+    z_list::list<int> l = {1, 2, 3, 4};
+    auto first = l.begin();
+    auto second = std::next(l.begin());
+    auto stale = std::next(l.begin(), 2);
+
+    // Erasing a node only invalidates the iterators on it.
+    l.erase(stale);
+    assert(rejects([&] { return *stale; }));
+    assert(rejects([&] { ++stale; }));
+    assert(rejects([&] { l.insert(stale, 9); }));
+    assert(*second == 2);
+
+    l.pop_front();
+    assert(rejects([&] { return *first; }));
+    assert(rejects([&] { return *l.end(); }));
+
+    // Iterators follow their node through splice and swap.
+    z_list::list<int> other = {7, 8};
+    auto seven = other.begin();
+    l.splice(std::move(other));
+    assert(*seven == 7);
+    assert(*--l.end() == 8);
+    l.erase(seven);
+    assert(rejects([&] { return *seven; }));
+
+    z_list::list<int> swapped = {5};
+    auto five = swapped.begin();
+    l.swap(swapped);
+    assert(*five == 5);
+    l.erase(five);
+
+    // Iterators must belong to the list they are passed to.
+    auto foreign = swapped.begin();
+    assert(rejects([&] { l.erase(foreign); }));
+
+    auto extracted = swapped.begin();
+    auto nh = swapped.extract(extracted);
+    assert(rejects([&] { return *extracted; }));
+
+    // Clearing or destroying a list leaves no usable iterator behind.
+    auto cleared = swapped.begin();
+    swapped.clear();
+    assert(rejects([&] { return *cleared; }));
+    assert(swapped.begin() == swapped.end());
+
+    z_list::list<int>::iterator orphan;
+    {
+        z_list::list<int> temp = {1};
+        orphan = temp.begin();
+    }
+    assert(rejects([&] { ++orphan; }));
+
+    PASS();
+}
+#endif
+
+#if ZLIST_HAS_PMR
+void test_pmr()
+{
+    TEST("std::pmr (Monotonic Buffer)");
+
+    unsigned char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    z_list::pmr::list<int> l(&arena);
+    for (int i = 0; i < 10; i++)
+    {
+        l.push_back(i);
+    }
+    assert(l.size() == 10);
+    assert(l.get_allocator().resource() == &arena);
+
+    // Copies use the default resource, moves keep the arena.
+    z_list::pmr::list<int> copy = l;
+    assert(copy.get_allocator().resource() == std::pmr::get_default_resource());
+    z_list::pmr::list<int> moved = std::move(l);
+    assert(moved.get_allocator().resource() == &arena);
+    assert(moved.back() == 9);
+
+    PASS();
+}
+#endif
+
+void test_probes()
+{
+    TEST("Static Probes (Generic Traits)");
+
+    using tr = z_list::traits<long>;
+    tr::list_type raw = tr::init();
+    probe_list = &raw;
+    tr::push_back(&raw, 1);
+    tr::push_front(&raw, 0);
+    tr::insert_after(&raw, raw.tail, 2);
+    tr::reverse(&raw);
+    tr::pop_back(&raw);
+    tr::remove_node(&raw, raw.head);
+    tr::clear(&raw);
+    assert(probe_log == "push_back generic push_front generic insert_after generic reverse generic "
+                        "pop_back generic remove generic clear generic ");
+
+    // The wrapper links and detaches nodes itself; registered types report their Name.
+    z_list::list<int> l;
+    probe_log.clear();
+    probe_list = &l.inner;
+    l.push_back(1);
+    l.pop_front();
+    assert(probe_log == "link Int detach Int ");
+    probe_list = nullptr;
+
+    PASS();
+}
+
 int main() 
 {
     std::cout << "=> Running tests (zlist.h, cpp).\n";
@@ -228,6 +937,29 @@ int main()
     test_splice();
     test_const_correctness();
     test_complex_types();
+    test_full_api();
+    test_unregistered();
+    test_probes();
+    test_relocation();
+    test_sort();
+    test_small_list();
+    test_allocator();
+    test_node_handles();
+#if ZLIST_HAS_RANGES
+    test_ranges();
+#endif
+#if ZLIST_HAS_COROUTINES
+    test_coroutines();
+#endif
+#if ZLIST_HAS_PARALLEL
+    test_parallel();
+#endif
+#if ZLIST_HAS_PMR
+    test_pmr();
+#endif
+#ifdef ZLIST_DEBUG_ITERATORS
+    test_debug_iterators();
+#endif
 
     std::cout << "=> All tests passed successfully.\n";
     return 0;
@@ -1,3 +1,5 @@
+#define _DEFAULT_SOURCE // fileno(), lseek(), syscall().
+
 
 #include <stdio.h>
 #include <assert.h>
@@ -14,7 +16,27 @@ typedef struct
     X(int, Int)                 \
     X(Vec2, Vec2)
 
+#define ZLIST_ENABLE_IO
+#define ZLIST_LOAD_BUFFER 16 // Forces refills and growth in test_load().
+#define ZLIST_ENABLE_MMAP
+#define ZLIST_ENABLE_SHM
+#define ZLIST_ENABLE_JOURNAL
+#define ZLIST_ENABLE_SNAPSHOT
+#define ZLIST_ENABLE_URING
+#define ZLIST_ENABLE_TIERED
+#define ZLIST_ENABLE_BORROWED
+#define ZLIST_ENABLE_STATS
+#define ZLIST_STATS_SAMPLE 1 // Time every call.
+#define ZLIST_ENABLE_MEMORY_REPORT
+#define ZLIST_ENABLE_PROBES
+#define ZLIST_PROBE(op, l, type, len) probe_hit(#op, l, type, len)
+static void probe_hit(const char *op, const void *l, const char *type, size_t length);
 #include "zlist.h"
+#include <unistd.h>
+#include <sys/wait.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/socket.h>
 
 #define TEST(name) printf("[TEST] %-35s", name);
 #define PASS() printf(" \033[0;32mPASS\033[0m\n")
@@ -70,6 +92,17 @@ void test_modification(void)
     assert(node_10->next->value == 15);
     assert(list.length == 4);
 
+    // Insert before: [0, 5, 10, 15, 20].
+    zlist_insert_before(&list, node_10, 5);
+    assert(node_10->prev->value == 5);
+    assert(list.length == 5);
+
+    // Insert before NULL appends: [0, 5, 10, 15, 20, 25].
+    zlist_insert_before(&list, NULL, 25);
+    assert(zlist_tail(&list)->value == 25);
+    zlist_pop_back(&list);
+    zlist_remove_node(&list, node_10->prev);
+
     // Pop front: [10, 15, 20].
     zlist_pop_front(&list);
     assert(zlist_head(&list)->value == 10);
@@ -191,6 +224,985 @@ void test_autofree(void)
 }
 #endif
 
+void test_io(void)
+{
+    TEST("Binary Write/Read (Checkpoint)");
+
+    zlist_Int src = zlist_init(Int);
+    for (int i = 0; i < 5000; i++)
+    {
+        zlist_push_back(&src, i * 3);
+    }
+
+    FILE *f = tmpfile();
+    assert(f != NULL);
+    int fd = fileno(f);
+    assert(zlist_write(&src, fd) == Z_OK);
+
+    // Reading appends after the existing elements.
+    zlist_Int dst = zlist_init(Int);
+    zlist_push_back(&dst, -1);
+    assert(lseek(fd, 0, SEEK_SET) == 0);
+    assert(zlist_read(&dst, fd) == Z_OK);
+    assert(dst.length == 5001);
+    assert(dst.head->value == -1);
+    zlist_node_Int *a = src.head;
+    zlist_node_Int *b = dst.head->next;
+    for (; a; a = a->next, b = b->next)
+    {
+        assert(a->value == b->value);
+    }
+    assert(dst.tail->value == 4999 * 3);
+
+    // Element size mismatch and a flipped payload byte are both rejected.
+    zlist_Vec2 wrong = zlist_init(Vec2);
+    assert(lseek(fd, 0, SEEK_SET) == 0);
+    assert(zlist_read(&wrong, fd) == Z_EINVAL);
+    assert(zlist_is_empty(&wrong));
+
+    unsigned char byte = 0xFF;
+    assert(pwrite(fd, &byte, 1, sizeof(zlist_io_header) + 7) == 1);
+    assert(lseek(fd, 0, SEEK_SET) == 0);
+    assert(zlist_read(&dst, fd) == Z_EINVAL);
+    assert(dst.length == 5001);
+
+    // A truncated stream fails too.
+    assert(ftruncate(fd, sizeof(zlist_io_header) + 10) == 0);
+    assert(lseek(fd, 0, SEEK_SET) == 0);
+    assert(zlist_read(&dst, fd) == Z_EINVAL);
+    assert(dst.length == 5001);
+
+    fclose(f);
+    zlist_clear(&src);
+    zlist_clear(&dst);
+
+    PASS();
+}
+
+// "<int>" per line; '#' lines are skipped, anything else is an error.
+static int parse_int_line(const char *line, size_t len, int *out, void *ctx)
+{
+    (*(int *)ctx)++;
+    if (len == 0 || line[0] == '#') return 0;
+    int v = 0;
+    int sign = 1;
+    size_t i = 0;
+    if (line[0] == '-')
+    {
+        sign = -1;
+        i = 1;
+    }
+    for (; i < len; i++)
+    {
+        if (line[i] < '0' || line[i] > '9') return -1;
+        v = v * 10 + (line[i] - '0');
+    }
+    *out = sign * v;
+    return 1;
+}
+
+void test_load(void)
+{
+    TEST("Text Loader (Parse Into Nodes)");
+
+    const char text[] = "# id\n1\r\n-22\n\n333\n00000000000000000000000000004444\n55555";
+    FILE *f = tmpfile();
+    assert(f != NULL);
+    assert(fwrite(text, 1, sizeof(text) - 1, f) == sizeof(text) - 1);
+    fflush(f);
+    int fd = fileno(f);
+
+    zlist_Int list = zlist_init(Int);
+    zlist_push_back(&list, 0);
+    int lines = 0;
+    assert(lseek(fd, 0, SEEK_SET) == 0);
+    assert(zlist_load(&list, fd, parse_int_line, &lines) == Z_OK);
+    assert(lines == 7 && list.length == 6);
+    int expect[] = { 0, 1, -22, 333, 4444, 55555 };
+    int i = 0;
+    zlist_foreach_decl(Int, &list, it)
+    {
+        assert(it->value == expect[i++]);
+    }
+
+    // A bad line fails the whole load and leaves the list alone.
+    assert(ftruncate(fd, 0) == 0);
+    assert(pwrite(fd, "7\n8\nx\n9\n", 8, 0) == 8);
+    assert(lseek(fd, 0, SEEK_SET) == 0);
+    assert(zlist_load(&list, fd, parse_int_line, &lines) == Z_EINVAL);
+    assert(list.length == 6);
+
+    fclose(f);
+    zlist_clear(&list);
+
+    PASS();
+}
+
+// Every value sends the same 5003-byte message, so writes to a pipe split nodes.
+#define SG_MSG 5003
+static unsigned char sg_pattern[SG_MSG];
+
+static struct iovec msg_iov(const int *value)
+{
+    (void)value;
+    struct iovec iov = { sg_pattern, SG_MSG };
+    return iov;
+}
+
+static int sent_count = 0;
+
+static void msg_sent(int *value)
+{
+    (void)value;
+    sent_count++;
+}
+
+// Reads what is there and checks it continues the pattern stream.
+static int drain_msgs(int fd, size_t *pos)
+{
+    unsigned char buf[8192];
+    ssize_t n = read(fd, buf, sizeof(buf));
+    for (ssize_t i = 0; i < n; i++, (*pos)++)
+    {
+        assert(buf[i] == sg_pattern[*pos % SG_MSG]);
+    }
+    return n > 0;
+}
+
+void test_scatter_gather(void)
+{
+    TEST("Scatter/Gather Send (writev)");
+
+    for (int i = 0; i < SG_MSG; i++)
+    {
+        sg_pattern[i] = (unsigned char)(i * 7);
+    }
+    zlist_Int out = zlist_init(Int);
+    for (int i = 0; i < 200; i++)
+    {
+        zlist_push_back(&out, i);
+    }
+
+    // A non-blocking pipe takes part of the queue per call.
+    int p[2];
+    assert(pipe(p) == 0);
+    assert(fcntl(p[1], F_SETFL, O_NONBLOCK) == 0);
+    size_t offset = 0;
+    size_t pos = 0;
+    int partial = 0;
+    while (!zlist_is_empty(&out))
+    {
+        assert(zlist_writev(&out, p[1], &offset, msg_iov, msg_sent) == Z_OK);
+        if (offset) partial = 1;
+        drain_msgs(p[0], &pos);
+    }
+    close(p[1]);
+    while (drain_msgs(p[0], &pos)) {}
+    close(p[0]);
+    assert(pos == 200 * (size_t)SG_MSG && sent_count == 200);
+    assert(partial && offset == 0);
+
+    // Same through sendmsg() on a socket.
+    int sv[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    for (int i = 0; i < 10; i++)
+    {
+        zlist_push_back(&out, i);
+    }
+    assert(zlist_sendmsg(&out, sv[0], MSG_NOSIGNAL, &offset, msg_iov, NULL) == Z_OK);
+    assert(zlist_is_empty(&out));
+    close(sv[0]);
+    pos = 0;
+    while (drain_msgs(sv[1], &pos)) {}
+    close(sv[1]);
+    assert(pos == 10 * (size_t)SG_MSG);
+
+    PASS();
+}
+
+static int uring_fd = -1;
+static int uring_write = 1;
+static int uring_failed = 0;
+
+// Each request is its own buffer: value v lives at offset 4 * v of the file.
+static void uring_prep(int *value, struct io_uring_sqe *sqe)
+{
+    sqe->opcode = uring_write ? IORING_OP_WRITE : IORING_OP_READ;
+    sqe->fd = uring_fd;
+    sqe->addr = (uint64_t)(uintptr_t)value;
+    sqe->len = sizeof(int);
+    sqe->off = (uint64_t)*value * sizeof(int);
+}
+
+static void uring_complete(int *value, int res)
+{
+    (void)value;
+    if (res != (int)sizeof(int)) uring_failed++;
+}
+
+void test_uring(void)
+{
+    TEST("io_uring Batches (Node Reuse)");
+
+    zlist_uring r;
+    if (zlist_uring_init(&r, 64) != Z_OK)
+    {
+        printf(" SKIP (io_uring unavailable)\n");
+        return;
+    }
+
+    FILE *f = tmpfile();
+    assert(f != NULL);
+    uring_fd = fileno(f);
+
+    zlist_Int pending = zlist_init(Int);
+    zlist_Int done = zlist_init(Int);
+    for (int i = 0; i < 4096; i++)
+    {
+        zlist_push_back(&pending, i);
+    }
+    zlist_node_Int *first = pending.head;
+
+    assert(zlist_uring_run(&r, &pending, &done, uring_prep, uring_complete) == Z_OK);
+    assert(zlist_is_empty(&pending) && done.length == 4096 && uring_failed == 0);
+    assert(r.enters < 4096 / 32);
+    for (int i = 0; i < 4096; i++)
+    {
+        int v = -1;
+        assert(pread(uring_fd, &v, sizeof(v), i * (off_t)sizeof(int)) == sizeof(v));
+        assert(v == i);
+    }
+
+    // Reads reuse the completed nodes: requeue them and read back in place.
+    zlist_splice(&pending, &done);
+    uring_write = 0;
+    unsigned long writes = r.enters;
+    assert(zlist_uring_submit(&r, &pending, uring_prep) == 64);
+    assert(zlist_uring_flush(&r, 64) == Z_OK);
+    assert(zlist_uring_reap(&r, &done, uring_complete) == 64);
+    assert(zlist_uring_run(&r, &pending, &done, uring_prep, uring_complete) == Z_OK);
+    assert(r.enters - writes < 4096 / 32 && uring_failed == 0);
+    long long sum = 0;
+    int found_first = 0;
+    zlist_foreach_decl(Int, &done, it)
+    {
+        sum += it->value;
+        found_first |= it == first;
+    }
+    assert(sum == 4095LL * 4096 / 2 && found_first);
+
+    zlist_clear(&done);
+    zlist_uring_exit(&r);
+    fclose(f);
+
+    PASS();
+}
+
+void test_tiered(void)
+{
+    TEST("Tiered List (Frozen Segments)");
+
+    // Slowly rising audit ids compress to about a byte each.
+    zlist_tiered_Int t = zlist_tiered_init(Int, &zlist_codec_delta_varint, 1024, 2048);
+    for (int i = 0; i < 100000; i++)
+    {
+        assert(zlist_tiered_push_back(&t, i * 3 - 50) == Z_OK);
+    }
+    assert(zlist_tiered_length(&t) == 100000);
+    assert(t.hot.length >= 2048 && t.hot.length < 2048 + 1024);
+    assert(t.cold_count + t.hot.length == 100000);
+    assert(t.cold_bytes < t.cold_count * 2);
+
+    zlist_tiered_iter_Int it = zlist_tiered_begin(&t);
+    const int *v;
+    int expect = 0;
+    while ((v = zlist_tiered_next(&it)))
+    {
+        assert(*v == expect * 3 - 50);
+        expect++;
+    }
+    assert(expect == 100000 && it.error == Z_OK);
+    zlist_tiered_iter_end(&it);
+
+    // The codec handles large jumps and negative deltas.
+    int tricky[] = { 0, 2147483647, -2147483647 - 1, 5, -5, 0 };
+    unsigned char enc[6 * 10];
+    int dec[6];
+    size_t n = zlist_codec_delta_varint.encode(tricky, 6, sizeof(int), enc);
+    assert(zlist_codec_delta_varint.decode(enc, n, 6, sizeof(int), dec) == Z_OK);
+    assert(memcmp(tricky, dec, sizeof(dec)) == 0);
+    assert(zlist_codec_delta_varint.decode(enc, n - 1, 6, sizeof(int), dec) == Z_EINVAL);
+    assert(zlist_codec_delta_varint.bound(6, 3) == 0);
+    assert(zlist_codec_delta_varint.decode(enc, n, 2, 12, dec) == Z_EINVAL);
+
+    // Any byte-copyable type works with the raw codec.
+    zlist_tiered_Vec2 points = zlist_tiered_init(Vec2, NULL, 16, 0);
+    for (int i = 0; i < 100; i++)
+    {
+        zlist_tiered_push_back(&points, ((Vec2){ (float)i, -1.0f }));
+    }
+    assert(points.cold_count == 96 && points.hot.length == 4);
+    zlist_tiered_iter_Vec2 pit = zlist_tiered_begin(&points);
+    const Vec2 *p;
+    float x = 0.0f;
+    while ((p = zlist_tiered_next(&pit)))
+    {
+        assert(p->x == x);
+        x += 1.0f;
+    }
+    assert(x == 100.0f);
+    zlist_tiered_iter_end(&pit);
+
+    zlist_tiered_clear(&t);
+    zlist_tiered_clear(&points);
+    assert(zlist_tiered_length(&t) == 0);
+
+    PASS();
+}
+
+void test_mmap(void)
+{
+    TEST("File-Backed List (mmap, Offsets)");
+
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/zlist_test_%ld.bin", (long)getpid());
+
+    // A tiny initial region forces several remaps while pushing.
+    zlist_mmap_Int m;
+    assert(zlist_mmap_create(&m, path, 4096) == Z_OK);
+    for (int i = 0; i < 20000; i++)
+    {
+        assert(zlist_mmap_push_back(&m, i) == Z_OK);
+    }
+    assert(zlist_mmap_push_front(&m, -1) == Z_OK);
+
+    int out = 0;
+    assert(zlist_mmap_pop_back(&m, &out) == Z_OK && out == 19999);
+    assert(zlist_mmap_pop_front(&m, &out) == Z_OK && out == -1);
+    assert(zlist_mmap_length(&m) == 19999);
+    assert(zlist_mmap_sync(&m) == Z_OK);
+    zlist_mmap_close(&m);
+
+    // Reopening maps the file at a new address; offsets still resolve.
+    assert(zlist_mmap_open(&m, path) == Z_OK);
+    assert(zlist_mmap_length(&m) == 19999);
+    int expected = 0;
+    zlist_mmap_foreach_decl(Int, &m, it)
+    {
+        assert(it->value == expected++);
+    }
+    assert(expected == 19999);
+    assert(zlist_mmap_tail(&m)->value == 19998);
+    assert(zlist_mmap_prev(&m, zlist_mmap_tail(&m))->value == 19997);
+
+    // Freed nodes are reused before the region grows.
+    zlist_mnode_Int *second = zlist_mmap_next(&m, zlist_mmap_head(&m));
+    uint64_t off = zlist_mmap_offset(&m, second);
+    zlist_mmap_remove_node(&m, second);
+    assert(zlist_mmap_push_back(&m, 42) == Z_OK);
+    assert(zlist_mmap_offset(&m, zlist_mmap_tail(&m)) == off);
+    assert(zlist_mmap_node(&m, off)->value == 42);
+
+    zlist_mmap_clear(&m);
+    assert(zlist_mmap_length(&m) == 0);
+    assert(zlist_mmap_pop_front(&m, NULL) == Z_EEMPTY);
+    zlist_mmap_close(&m);
+
+    // A file left longer than its capacity by a failed grow still opens.
+    struct stat st;
+    assert(stat(path, &st) == 0 && truncate(path, 2 * st.st_size) == 0);
+    assert(zlist_mmap_open(&m, path) == Z_OK);
+    assert(zlist_mmap_push_back(&m, 7) == Z_OK && zlist_mmap_tail(&m)->value == 7);
+    zlist_mmap_close(&m);
+
+    // Roots that do not name a node slot are rejected at open.
+    int fd = open(path, O_RDWR);
+    uint64_t bad = 3;
+    assert(pwrite(fd, &bad, sizeof(bad), offsetof(zlist_region_header, head)) == sizeof(bad));
+    close(fd);
+    assert(zlist_mmap_open(&m, path) == Z_EINVAL);
+
+    // The header records the element type.
+    zlist_mmap_Vec2 wrong;
+    assert(zlist_mmap_open(&wrong, path) == Z_EINVAL);
+    unlink(path);
+
+    PASS();
+}
+
+void test_shm(void)
+{
+    TEST("Shared-Memory List (fork, Robust)");
+
+    char name[64];
+    snprintf(name, sizeof(name), "/zlist_test_%ld", (long)getpid());
+
+    const size_t capacity = 64 * 1024;
+    zlist_shm_Int q;
+    assert(zlist_shm_create(&q, name, capacity) == Z_OK);
+
+    // A producer process hands records to this one through the shared list.
+    pid_t pid = fork();
+    if (0 == pid)
+    {
+        zlist_shm_Int p;
+        if (zlist_shm_open(&p, name) != Z_OK) _exit(1);
+        for (int i = 0; i < 1000; i++)
+        {
+            if (zlist_shm_push_back(&p, i) != Z_OK) _exit(1);
+        }
+        zlist_shm_close(&p);
+        _exit(0);
+    }
+    for (int i = 0; i < 1000; i++)
+    {
+        int v = -1;
+        assert(zlist_shm_pop_front(&q, &v, 5000) == Z_OK);
+        assert(v == i);
+    }
+    int status = 0;
+    assert(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && 0 == WEXITSTATUS(status));
+    assert(zlist_shm_pop_front(&q, NULL, 10) == Z_EEMPTY);
+
+    // A process dies mid-push: one node leaked, the other half linked.
+    zlist_shm_push_back(&q, 1);
+    zlist_shm_push_back(&q, 2);
+    pid = fork();
+    if (0 == pid)
+    {
+        zlist_shm_lock(&q);
+        zlist_region_header *h = ZLIST_REGION_HDR(&q.region);
+        zlist_region_alloc(&q.region);
+        uint64_t off = zlist_region_alloc(&q.region);
+        zlist_mnode_Int *n = (zlist_mnode_Int *)(q.region.base + off);
+        n->value = 3;
+        n->next = 0;
+        ZLIST_REGION_AT(&q.region, h->tail)->next = off;
+        _exit(0);
+    }
+    assert(waitpid(pid, &status, 0) == pid);
+
+    // The next locker repairs tail/length and reclaims the leaked node.
+    assert(zlist_shm_length(&q) == 3);
+    assert(ZLIST_SHM_HDR(&q.region)->recoveries == 1);
+    int v = 0;
+    assert(zlist_shm_pop_back(&q, &v) == Z_OK && v == 3);
+    assert(zlist_shm_pop_front(&q, &v, 0) == Z_OK && v == 1);
+    assert(zlist_shm_pop_front(&q, &v, 0) == Z_OK && v == 2);
+
+    size_t header = ZLIST_REGION_HDR(&q.region)->header_size;
+    size_t slots = (capacity - header) / sizeof(zlist_mnode_Int);
+    size_t pushed = 0;
+    while (zlist_shm_push_front(&q, (int)pushed) == Z_OK) pushed++;
+    assert(pushed == slots);
+
+    zlist_shm_close(&q);
+
+    // File and shared regions share a layout but not a kind; each opener refuses the other.
+    char path[80];
+    snprintf(path, sizeof(path), "/dev/shm%s", name);
+    zlist_mmap_Int f;
+    assert(zlist_mmap_open(&f, path) == Z_EINVAL);
+    assert(zlist_shm_unlink(name) == Z_OK);
+    assert(zlist_mmap_create(&f, path, 4096) == Z_OK);
+    zlist_mmap_close(&f);
+    assert(zlist_shm_open(&q, name) == Z_EINVAL);
+    assert(zlist_shm_unlink(name) == Z_OK);
+
+    PASS();
+}
+
+static void assert_same_ints(const zlist_Int *a, const zlist_Int *b)
+{
+    assert(a->length == b->length);
+    zlist_node_Int *x = a->head;
+    zlist_node_Int *y = b->head;
+    for (; x; x = x->next, y = y->next)
+    {
+        assert(x->value == y->value);
+    }
+    assert(y == NULL);
+}
+
+void test_journal(void)
+{
+    TEST("Journal (WAL Replay, Compact)");
+
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/zlist_journal_%ld.log", (long)getpid());
+    unlink(path);
+
+    // Existing nodes are logged on attach; group commit every 64 records.
+    zlist_journal j;
+    zlist_Int list = zlist_init(Int);
+    zlist_push_back(&list, 100);
+    assert(zlist_journal_open(&j, path, 64) == Z_OK);
+    assert(zlist_journal_attach(&list, &j) == Z_OK);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        zlist_push_back(&list, i);
+    }
+    zlist_push_front(&list, -1);
+    zlist_insert_after(&list, list.head, -2);
+    zlist_insert_before(&list, list.tail, -3);
+    zlist_pop_back(&list);
+    zlist_pop_front(&list);
+    zlist_remove_node(&list, zlist_at(&list, 10));
+    zlist_reverse(&list);
+
+    zlist_Int other = zlist_init(Int);
+    zlist_push_back(&other, 7);
+    zlist_push_back(&other, 8);
+    zlist_splice(&list, &other);
+    assert(zlist_journal_commit(&j) == Z_OK);
+
+    zlist_Int copy = zlist_init(Int);
+    assert(zlist_journal_replay(&copy, path) == Z_OK);
+    assert_same_ints(&list, &copy);
+    zlist_clear(&copy);
+
+    // A torn record from a crash mid-append is cut off; the prefix survives.
+    int fd = open(path, O_WRONLY | O_APPEND);
+    assert(fd >= 0);
+    unsigned char torn[3] = { ZLIST_JOP_LINK, 0, 42 };
+    assert(write(fd, torn, sizeof(torn)) == 3);
+    close(fd);
+    struct stat before;
+    assert(stat(path, &before) == 0);
+    assert(zlist_journal_replay(&copy, path) == Z_OK);
+    assert_same_ints(&list, &copy);
+    struct stat after;
+    assert(stat(path, &after) == 0);
+    assert(after.st_size == before.st_size - 3);
+    zlist_clear(&copy);
+
+    // Compaction keeps the contents and shrinks the log to one record per node.
+    assert(zlist_journal_compact(&list) == Z_OK);
+    assert(j.size < (uint64_t)before.st_size);
+    zlist_push_back(&list, 5);
+    zlist_clear(&list);
+    zlist_push_back(&list, 6);
+    zlist_journal_attach(&list, NULL);
+    zlist_journal_close(&j);
+
+    assert(zlist_journal_replay(&copy, path) == Z_OK);
+    assert(copy.length == 1 && copy.head->value == 6);
+
+    // Replay continues an existing log after re-attaching.
+    assert(zlist_journal_open(&j, path, 0) == Z_OK);
+    assert(zlist_journal_attach(&copy, &j) == Z_OK);
+    zlist_push_front(&copy, 9);
+    zlist_journal_attach(&copy, NULL);
+    zlist_journal_close(&j);
+    zlist_clear(&list);
+    assert(zlist_journal_replay(&list, path) == Z_OK);
+    assert_same_ints(&list, &copy);
+
+    // Without a replay, a list with nodes cannot join the log; ids continue past the log's.
+    zlist_Int fresh = zlist_init(Int);
+    zlist_push_back(&fresh, 1);
+    assert(zlist_journal_open(&j, path, 0) == Z_OK);
+    assert(zlist_journal_attach(&fresh, &j) == Z_EINVAL);
+    zlist_clear(&fresh);
+    assert(zlist_journal_attach(&fresh, &j) == Z_OK);
+    assert(j.next_id > copy.head->jid && j.next_id > copy.tail->jid);
+    zlist_journal_attach(&fresh, NULL);
+    zlist_journal_close(&j);
+
+    zlist_clear(&list);
+    zlist_clear(&copy);
+    unlink(path);
+
+    PASS();
+}
+
+static int sum_snapshot(zlist_snapshot_Int *snap, size_t *count)
+{
+    int sum = 0;
+    *count = 0;
+    zlist_snapshot_foreach_decl(Int, snap, it)
+    {
+        sum += it->value;
+        (*count)++;
+    }
+    return sum;
+}
+
+static void *snapshot_reader(void *arg)
+{
+    zlist_snapshot_Int *snap = (zlist_snapshot_Int *)arg;
+    for (int round = 0; round < 200; round++)
+    {
+        size_t count;
+        if (sum_snapshot(snap, &count) != 499500 || count != 1000) return NULL;
+    }
+    zlist_snapshot_release(snap);
+    return snap;
+}
+
+void test_snapshot(void)
+{
+    TEST("Snapshots (Versioned Links)");
+
+    zlist_history h;
+    zlist_history_init(&h);
+    zlist_Int list = zlist_init(Int);
+    for (int i = 0; i < 1000; i++)
+    {
+        zlist_push_back(&list, i);
+    }
+    zlist_history_attach(&list, &h);
+
+    // A snapshot keeps its view through every kind of mutation.
+    zlist_snapshot_Int *a = zlist_snapshot(&list);
+    assert(a != NULL && zlist_snapshot_length(a) == 1000);
+    zlist_pop_front(&list);
+    zlist_pop_back(&list);
+    zlist_remove_node(&list, zlist_at(&list, 500));
+    zlist_insert_after(&list, zlist_at(&list, 10), -5);
+    zlist_push_front(&list, 77);
+    zlist_reverse(&list);
+    zlist_snapshot_Int *b = zlist_snapshot(&list);
+    zlist_push_back(&list, 1);
+    zlist_node_Int *moved = zlist_detach_node(&list, zlist_at(&list, 3));
+    zlist_link_before(&list, list.head, moved);
+    zlist_clear(&list);
+
+    size_t count;
+    assert(sum_snapshot(a, &count) == 499500 && count == 1000);
+    int expect = 499500 - 0 - 999 - 501 - 5 + 77;
+    assert(sum_snapshot(b, &count) == expect && count == 999);
+    assert(zlist_snapshot_head(b)->value == 998);
+    assert(zlist_snapshot_intact(a) && zlist_snapshot_intact(b));
+
+    // Freed nodes wait for the last snapshot that can reach them.
+    zlist_snapshot_release(a);
+    zlist_history_collect(&h);
+    assert(h.live == 1 && h.limbo != NULL);
+    assert(sum_snapshot(b, &count) == expect);
+    zlist_snapshot_release(b);
+    zlist_history_collect(&h);
+    assert(h.live == 0 && h.limbo == NULL);
+
+    // A reader thread walks its snapshot while the writer keeps mutating.
+    for (int i = 0; i < 1000; i++)
+    {
+        zlist_push_back(&list, i);
+    }
+    zlist_snapshot_Int *c = zlist_snapshot(&list);
+    pthread_t reader;
+    assert(pthread_create(&reader, NULL, snapshot_reader, c) == 0);
+    for (int i = 0; i < 20000; i++)
+    {
+        zlist_pop_front(&list);
+        zlist_push_back(&list, i);
+        if (i % 1000 == 0) zlist_reverse(&list);
+    }
+    void *ok = NULL;
+    assert(pthread_join(reader, &ok) == 0 && ok == c);
+
+    // Splicing out of a history drops the moved nodes' records once no snapshot is live.
+    zlist_snapshot_Int *d = zlist_snapshot(&list);
+    zlist_reverse(&list);
+    assert(list.head->shist != NULL);
+    zlist_snapshot_release(d);
+    zlist_Int plain = zlist_init(Int);
+    zlist_splice(&plain, &list);
+    assert(plain.head->shist == NULL && plain.head->sstamp == ZLIST_HISTORY_FRESH);
+    zlist_clear(&plain);
+
+    zlist_clear(&list);
+    zlist_history_attach(&list, NULL);
+    zlist_history_destroy(&h);
+    assert(h.limbo == NULL && h.snapshots == NULL);
+
+    PASS();
+}
+
+typedef struct
+{
+    zlist_node_Int *base;
+    size_t count;
+    int returned[8];
+    size_t heap;
+} BorrowPool;
+
+static void borrow_release(zlist_node_Int *n, void *ctx)
+{
+    BorrowPool *pool = ctx;
+    if (n >= pool->base && n < pool->base + pool->count)
+    {
+        pool->returned[n - pool->base]++;
+        return;
+    }
+    pool->heap++;
+    ZLIST_FREE(n);
+}
+
+void test_borrowed(void)
+{
+    TEST("Borrowed Nodes (Release Callback)");
+
+    // One block owned by the caller, standing in for a DMA or message arena.
+    zlist_node_Int *frame = malloc(8 * sizeof(*frame));
+    assert(frame);
+    BorrowPool pool = { frame, 8, { 0 }, 0 };
+    for (int i = 0; i < 8; i++) frame[i].value = i;
+
+    zlist_Int list = zlist_init(Int);
+    zlist_set_release(&list, borrow_release, &pool);
+    zlist_borrow_array(&list, frame, 8);
+    assert(list.length == 8 && list.head == &frame[0] && list.tail == &frame[7]);
+
+    // Heap nodes mix freely with borrowed ones.
+    zlist_push_back(&list, 100);
+    zlist_reverse(&list);
+    assert(list.head->value == 100 && list.tail == &frame[0]);
+
+    zlist_pop_front(&list);
+    assert(pool.heap == 1);
+    zlist_pop_back(&list);
+    assert(pool.returned[0] == 1);
+    zlist_remove_node(&list, &frame[4]);
+    assert(pool.returned[4] == 1);
+
+    // Splice keeps the borrowed nodes in place; only 'dest' releases them.
+    zlist_Int other = zlist_init(Int);
+    zlist_splice(&other, &list);
+    assert(other.length == 6 && list.length == 0);
+    zlist_set_release(&other, borrow_release, &pool);
+    zlist_clear(&other);
+    for (int i = 0; i < 8; i++) assert(pool.returned[i] == 1);
+    assert(frame[3].value == 3);
+
+    // Without a callback the list frees its nodes as usual.
+    zlist_Int owned = zlist_init(Int);
+    zlist_set_release(&owned, borrow_release, &pool);
+    zlist_set_release(&owned, NULL, NULL);
+    zlist_push_back(&owned, 1);
+    zlist_clear(&owned);
+    assert(pool.heap == 1);
+
+    // With a snapshot live, dropped nodes reach the callback only when it is released.
+    zlist_history h;
+    zlist_history_init(&h);
+    zlist_Int versioned = zlist_init(Int);
+    zlist_history_attach(&versioned, &h);
+    zlist_set_release(&versioned, borrow_release, &pool);
+    zlist_borrow_array(&versioned, frame, 2);
+    zlist_push_back(&versioned, 2);
+    zlist_snapshot_Int *snap = zlist_snapshot(&versioned);
+    zlist_clear(&versioned);
+    assert(pool.returned[0] == 1 && pool.heap == 1);
+    zlist_snapshot_release(snap);
+    zlist_history_destroy(&h);
+    assert(pool.returned[0] == 2 && pool.returned[1] == 2 && pool.heap == 2);
+    free(frame);
+
+    PASS();
+}
+
+void test_stats(void)
+{
+    TEST("Operation Statistics");
+
+    zlist_Int list = zlist_init(Int);
+    for (int i = 0; i < 10; i++) zlist_push_back(&list, i);
+    zlist_push_front(&list, -1);
+    zlist_insert_after(&list, list.head, 100);
+    zlist_pop_back(&list);
+    zlist_pop_front(&list);
+    zlist_remove_node(&list, list.head);
+    assert(zlist_at(&list, 5)->value == 5);
+    assert(zlist_at(&list, 50) == NULL);
+    zlist_reverse(&list);
+
+    assert(list.stats.count[ZLIST_STAT_PUSH] == 11);
+    assert(list.stats.count[ZLIST_STAT_INSERT] == 1);
+    assert(list.stats.count[ZLIST_STAT_POP] == 2);
+    assert(list.stats.count[ZLIST_STAT_REMOVE] == 1);
+    assert(list.stats.count[ZLIST_STAT_AT] == 1 && list.stats.at_steps == 5);
+    assert(list.stats.count[ZLIST_STAT_REVERSE] == 1);
+    assert(list.stats.peak_length == 12);
+
+    uint64_t samples = 0;
+    for (int b = 0; b < ZLIST_STATS_BUCKETS; b++) samples += list.stats.hist[ZLIST_STAT_PUSH][b];
+    assert(samples == 11);
+
+    // Splices count on the destination.
+    zlist_Int other = zlist_init(Int);
+    zlist_push_back(&other, 7);
+    zlist_splice(&list, &other);
+    assert(list.stats.count[ZLIST_STAT_SPLICE] == 1);
+    assert(other.stats.count[ZLIST_STAT_SPLICE] == 0);
+
+    FILE *f = tmpfile();
+    assert(f);
+    zlist_stats_dump(&list, f);
+    char buf[1024];
+    rewind(f);
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    buf[n] = '\0';
+    fclose(f);
+    assert(strstr(buf, "zlist_Int ") && strstr(buf, "peak 12"));
+    assert(strstr(buf, " push 11 ") && strstr(buf, "at walked 5 steps"));
+    assert(strstr(buf, "push     11 samples"));
+
+    zlist_stats_reset(&list);
+    assert(list.stats.count[ZLIST_STAT_PUSH] == 0 && list.stats.peak_length == list.length);
+
+    zlist_clear(&list);
+    PASS();
+}
+
+void test_memory_report(void)
+{
+    TEST("Memory Accounting");
+
+    // Other tests share these counters; compare against a baseline.
+    uint64_t live = zlist_memory_Int.live, allocs = zlist_memory_Int.allocs;
+    zlist_Int list = zlist_init(Int);
+    for (int i = 0; i < 100; i++) zlist_push_back(&list, i);
+    for (int i = 0; i < 40; i++) zlist_pop_front(&list);
+    assert(zlist_memory_Int.live == live + 60);
+    assert(zlist_memory_Int.allocs == allocs + 100);
+    assert(zlist_memory_Int.peak >= live + 100);
+    assert(zlist_memory_Int.node_size == sizeof(zlist_node_Int));
+
+    // Nodes made by the I/O paths are counted too.
+    int fds[2];
+    assert(pipe(fds) == 0);
+    assert(zlist_write(&list, fds[1]) == Z_OK);
+    close(fds[1]);
+    zlist_Int copy = zlist_init(Int);
+    assert(zlist_read(&copy, fds[0]) == Z_OK);
+    close(fds[0]);
+    assert(zlist_memory_Int.live == live + 120);
+
+    FILE *f = tmpfile();
+    assert(f);
+    size_t heap = zlist_memory_report(f);
+    assert(heap >= 120 * sizeof(zlist_node_Int));
+    assert(heap == zlist_memory_report(NULL));
+    char buf[2048];
+    rewind(f);
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    buf[n] = '\0';
+    fclose(f);
+    assert(strstr(buf, "\nInt ") && strstr(buf, "\nVec2 ") && strstr(buf, "\ntotal "));
+
+    zlist_clear(&list);
+    zlist_clear(&copy);
+    assert(zlist_memory_Int.live == live);
+
+    // Heap nodes handed to a release callback count as freed; borrowed ones never counted.
+    zlist_node_Int frame[2];
+    BorrowPool pool = { frame, 2, { 0 }, 0 };
+    zlist_Int borrowed = zlist_init(Int);
+    zlist_set_release(&borrowed, borrow_release, &pool);
+    zlist_borrow_array(&borrowed, frame, 2);
+    zlist_push_back(&borrowed, 1);
+    assert(zlist_memory_Int.live == live + 1);
+    zlist_clear(&borrowed);
+    assert(zlist_memory_Int.live == live && pool.heap == 1);
+
+    // So do nodes reaped from a snapshot history.
+    zlist_history h;
+    zlist_history_init(&h);
+    zlist_history_attach(&list, &h);
+    zlist_push_back(&list, 1);
+    zlist_snapshot_Int *snap = zlist_snapshot(&list);
+    zlist_clear(&list);
+    assert(zlist_memory_Int.live == live + 1);
+    zlist_snapshot_release(snap);
+    zlist_history_destroy(&h);
+    assert(zlist_memory_Int.live == live);
+    PASS();
+}
+
+static struct
+{
+    const void *list;
+    char ops[256];
+    size_t length;
+} probes;
+
+static void probe_hit(const char *op, const void *l, const char *type, size_t length)
+{
+    if (l != probes.list) return;
+    assert(strcmp(type, "Int") == 0);
+    strncat(probes.ops, op, sizeof(probes.ops) - strlen(probes.ops) - 2);
+    strcat(probes.ops, " ");
+    probes.length = length;
+}
+
+void test_probes(void)
+{
+    TEST("Static Probes");
+
+    zlist_Int list = zlist_init(Int);
+    zlist_Int other = zlist_init(Int);
+    probes.list = &list;
+    zlist_push_back(&list, 1);
+    zlist_push_front(&list, 0);
+    zlist_insert_after(&list, list.tail, 2);
+    zlist_insert_before(&list, list.head, -1);
+    assert(probes.length == 4);
+    zlist_reverse(&list);
+    zlist_pop_back(&list);
+    zlist_pop_front(&list);
+    zlist_remove_node(&list, list.head);
+    zlist_node_Int *n = zlist_detach_node(&list, list.head);
+    zlist_link_before(&list, NULL, n);
+    zlist_push_back(&other, 9);
+    zlist_splice(&list, &other);
+    assert(probes.length == 2);
+    zlist_clear(&list);
+    assert(probes.length == 0);
+    assert(strcmp(probes.ops, "push_back push_front insert_after insert_before reverse pop_back "
+                              "pop_front remove detach link splice clear ") == 0);
+    probes.list = NULL;
+
+    PASS();
+}
+
+void test_locality(void)
+{
+    TEST("Locality Report");
+
+    // Nodes from one array: sequential, one hop per node.
+    zlist_node_Int *frame = malloc(1000 * sizeof(*frame));
+    assert(frame);
+    zlist_Int packed = zlist_init(Int);
+    for (int i = 0; i < 1000; i++) zlist_link_before(&packed, NULL, &frame[i]);
+    zlist_locality r = zlist_locality_report(&packed);
+    assert(r.nodes == 1000 && r.node_size == sizeof(zlist_node_Int));
+    assert(r.avg_delta == (double)sizeof(zlist_node_Int));
+    assert(r.within_line == 1.0 && r.within_page == 1.0 && r.forward == 1.0);
+    assert(r.pages >= r.pages_min && r.pages <= r.pages_min + 1);
+
+    // Interleaving the array halves spreads every hop across it.
+    zlist_Int mixed = zlist_init(Int);
+    while (!zlist_is_empty(&packed)) zlist_detach_node(&packed, packed.head);
+    for (int i = 0; i < 500; i++)
+    {
+        zlist_link_before(&mixed, NULL, &frame[i]);
+        zlist_link_before(&mixed, NULL, &frame[999 - i]);
+    }
+    zlist_locality m = zlist_locality_report(&mixed);
+    assert(m.nodes == 1000 && m.pages == r.pages);
+    assert(m.avg_delta > 100.0 * r.avg_delta);
+    assert(m.within_line < 0.01 && m.forward > 0.49 && m.forward < 0.51);
+
+    zlist_Int empty = zlist_init(Int);
+    zlist_locality e = zlist_locality_report(&empty);
+    assert(e.nodes == 0 && e.pages == 0 && e.avg_delta == 0.0);
+
+    free(frame);
+    PASS();
+}
+
 int main(void) 
 {
     printf("=> Running tests (zlist.h, main).\n");
@@ -199,6 +1211,20 @@ int main(void)
     test_modification();
     test_data_access();
     test_algorithms();
+    test_locality();
+    test_io();
+    test_load();
+    test_scatter_gather();
+    test_uring();
+    test_tiered();
+    test_borrowed();
+    test_stats();
+    test_memory_report();
+    test_probes();
+    test_mmap();
+    test_shm();
+    test_journal();
+    test_snapshot();
 
 #   if defined(__GNUC__) || defined(__clang__)
     test_autofree();